@@ -0,0 +1,24 @@
+# runs the suite ${SUITE} of ${EXECUTABLE} in ${MODE}, and fails when the output differs from that of replaying the
+# sections in a single thread
+foreach(RUN reference mode)
+	if(RUN STREQUAL "reference")
+		set(ARGUMENTS --single-threaded)
+	else()
+		set(ARGUMENTS ${MODE})
+	endif()
+	execute_process(
+		COMMAND ${EXECUTABLE} --no-source --timing none --seed 1 --category ${SUITE} ${ARGUMENTS}
+		RESULT_VARIABLE ${RUN}_result
+		OUTPUT_VARIABLE ${RUN}_output
+		ERROR_VARIABLE ${RUN}_error
+	)
+	if(NOT ${RUN}_result EQUAL 0)
+		message(FATAL_ERROR "'${SUITE}' failed with ${ARGUMENTS}:\n${${RUN}_output}${${RUN}_error}")
+	endif()
+	# the wall clock time of the totals differs from run to run
+	string(REGEX REPLACE "\\(real [^)]*\\)" "" ${RUN}_output "${${RUN}_output}")
+endforeach()
+
+if(NOT reference_output STREQUAL mode_output)
+	message(FATAL_ERROR "'${SUITE}' differs with ${MODE}:\n${mode_output}\nwhen replayed:\n${reference_output}")
+endif()
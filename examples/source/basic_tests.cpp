@@ -3,8 +3,27 @@
 #include <litmus/suite.hpp>
 #include <litmus/section.hpp>
 #include <litmus/expect.hpp>
+#include <litmus/expect_range.hpp>
+#include <litmus/approx.hpp>
 #include <litmus/benchmark.hpp>
+#include <litmus/fixture.hpp>
+#include <litmus/task.hpp>
+#include <litmus/thread.hpp>
+#include <litmus/explore.hpp>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 
 #include <litmus/generator/range.hpp>
@@ -111,8 +130,224 @@ auto section_test = suite<"section">() = []() {
 	*/
 };
 
-// auto benchmark = benchmark<"queue">() = [] {
-// 	section<"insertion">() = [] {
+/*
+	every section path sees the state its enclosing scopes built up to the section, whether the suite is replayed
+	or the sections are forked ('--fork-sections'), the output of both modes is compared by the tests of the examples
+*/
+auto nested_section_test = suite<"nested_sections", "sections">() = [] {
+	std::vector<int> values{1, 2, 3};
+	expect(values.size()) == 3u;
+	section<"push">() = [&] {
+		values.emplace_back(4);
+		expect(values.size()) == 4u;
+		section<"pop">() = [&] {
+			values.pop_back();
+			expect(values.back()) == 3;
+			section<"clear">() = [&] {
+				values.clear();
+				expect(values.empty()) == true;
+			};
+			section<"push">() = [&] { expect(values.emplace_back(5)) == 5; };
+		};
+		section<"sum">() = [&] { expect(std::accumulate(values.begin(), values.end(), 0)) == 10; };
+	};
+	section<"erase">() = [&] {
+		values.erase(values.begin());
+		expect(values.front()) == 2;
+		section<"sum">() = [&] { expect(std::accumulate(values.begin(), values.end(), 0)) == 5; };
+	};
+};
+
+// the table is built once and shared by every section replay and permutation
+auto squares = fixture([] {
+	std::vector<size_t> table{};
+	for(size_t i = 0; i < 1024; ++i) table.emplace_back(i * i);
+	return table;
+});
+
+auto shared_fixture_test = suite<"shared_fixture">(range<size_t, 0, 9>{}, squares) =
+	[](size_t value, const std::vector<size_t>& table) {
+		section<"lookup">() = [&] { expect(table[value]) == value * value; };
+		section<"size">() = [&] { expect(table.size()) == 1024u; };
+	};
+
+// keyed fixtures are built once per unique set of the other arguments
+auto keyed_fixture_test = suite<"keyed_fixture">(array<2, 4, 8>{}, fixture([](int size) {
+													 return std::vector<int>(static_cast<size_t>(size), size);
+												 })) = [](int size, const std::vector<int>& values) {
+	expect(values.size()) == static_cast<size_t>(size);
+	expect(values.front()) == size;
+};
+
+/*
+	'--aggregate' folds the results of a call site into its first pass and its first failures, a run with
+	'--aggregate 1' reports "(99 more passes)" for the loop. Failures are folded into the last kept failure, which the
+	second half shows on a result of its own, as a failing expect would fail the example.
+*/
+auto aggregate_test = suite<"aggregate", "aggregation">() = [] {
+	for(size_t i = 0; i < 100; ++i) expect(i % 10) < 10u;
 
-// 	};
-// };
+	using operation_t = test_result_t::expect_t::operation_t;
+	test_result_t results{};
+	results.scope_open("loop", {}, source_location::current());
+	const auto location = source_location::current();
+	for(size_t i = 0; i < 100; ++i)
+	{
+		const auto pass = (i % 10) != 0;
+		if(!results.aggregate(location, pass, false, 2))
+			results.expect_result("lhs", "rhs", {}, {}, operation_t::equal, pass, false, {});
+	}
+	results.scope_close();
+
+	const auto& root = results.root();
+	expect(root.pass) == 90u;
+	expect(root.fail) == 10u;
+	// the scope, the first pass, the 2 kept failures and the end of the scope
+	require(results.results.size()) == 5u;
+	expect(std::get<test_result_t::expect_t>(results.results[2]).repeats) == 89u;
+	expect(std::get<test_result_t::expect_t>(results.results[3]).repeats) == 8u;
+	expect(std::get<test_result_t::expect_t>(results.results[3]).repeats_text()) ==
+		std::string{" (8 more failures suppressed)"};
+};
+
+// a single result is recorded for the entire buffer, no matter its size
+auto range_test = suite<"range_expectations">() = [] {
+	std::vector<int> output(1u << 20u);
+	for(size_t i = 0; i < output.size(); ++i) output[i] = static_cast<int>(i % 7);
+	auto expected = output;
+
+	expect_range(output) == expected;
+	expect_range(output) < 7;
+	expect_range(output) == satisfies([](int value) { return value >= 0; });
+	expect_range(std::span{output}.subspan(1, 5)) != satisfies([](int value) { return value == 0; });
+};
+
+auto approx_test = suite<"approx">() = [] {
+	expect(0.1f + 0.2f) == approx(0.3f).ulps(1);
+	expect(1000.0) == approx(1000.1).rel(1e-3);
+	expect(1e-12) == approx(0.0).abs(1e-9);
+	expect(std::numeric_limits<int>::max()) != approx(std::numeric_limits<int>::min()).ulps(4);
+
+	// distances of integers can't overflow, which a constant evaluation would reject
+	static_assert(ulp_distance(std::numeric_limits<int>::max(), std::numeric_limits<int>::min()) == 0xffffffffu);
+	static_assert(ulp_distance(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()) ==
+				  std::numeric_limits<std::uint64_t>::max());
+
+	std::vector<float> values(1024), expected(1024);
+	for(size_t i = 0; i < values.size(); ++i)
+	{
+		values[i]	= static_cast<float>(i) * 0.1f;
+		expected[i] = static_cast<float>(static_cast<double>(i) * 0.1);
+	}
+	expect_range(values) == approx(expected).rel(1e-6);
+};
+
+auto delayed_double(int value) -> task<int>
+{
+	co_await sleep_for(std::chrono::milliseconds(1));
+	co_return value * 2;
+}
+
+// every permutation waits at the same time, the suite takes roughly 5ms instead of 5ms per value
+auto coroutine_test = suite<"coroutine">(range<int, 0, 99>{}) = [](int value) -> task<> {
+	co_await sleep_for(std::chrono::milliseconds(5));
+	expect(co_await delayed_double(value)) == value * 2;
+};
+
+#if defined(__linux__)
+// two readers and a writer wait on one end of a socket, the writer is resumed first as the data only arrives later
+auto shared_descriptor_test = suite<"shared_descriptor">() = [] {
+	int fds[2]{};
+	require(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds)) == 0;
+
+	int readers{0};
+	bool written{false};
+	auto reader = [&]() -> task<> {
+		co_await readable(fds[0]);
+		++readers;
+	};
+	auto writer = [&]() -> task<> {
+		co_await writable(fds[0]);
+		written = readers == 0;
+	};
+	auto sender = [&]() -> task<> {
+		co_await sleep_for(std::chrono::milliseconds(2));
+		[[maybe_unused]] const auto sent = ::write(fds[1], "x", 1);
+	};
+	{
+		event_loop_t loop{};
+		spawn(loop, reader());
+		spawn(loop, reader());
+		spawn(loop, writer());
+		spawn(loop, sender());
+		loop.run();
+	}
+	expect(readers) == 2;
+	expect(written) == true;
+	::close(fds[0]);
+	::close(fds[1]);
+};
+#endif
+
+// expects of the workers are recorded in the section that started them
+auto thread_test = suite<"threads">() = [] {
+	section<"workers">() = [] {
+		std::atomic<int> total{0};
+		{
+			std::vector<litmus::thread> workers{};
+			for(int i = 0; i < 4; ++i)
+				workers.emplace_back([&total](int id) {
+					expect(id) < 4;
+					total += id;
+				}, i);
+		}
+		expect(total.load()) == 6;
+	};
+};
+
+// every schedule interleaves the increments differently, a separate load and store would lose one of them
+auto explore_test = suite<"explore">().explore(50) = [] {
+	explore::atomic<int> counter{0};
+	{
+		explore::thread first{[&counter] { counter.fetch_add(1); }};
+		explore::thread second{[&counter] { counter.fetch_add(1); }};
+	}
+	expect(counter.load()) == 2;
+};
+
+// only runs with '--benchmarks', reports the latency percentiles of a single push
+auto push_benchmark = benchmark<"vector_push">().iterations(100000) = [] {
+	static std::vector<int> values{};
+	values.push_back(5);
+	do_not_optimize(values.data());
+};
+
+// timings with a fixed overhead per invocation fit the class they scale with, not a lower one
+auto complexity_fit_test = suite<"complexity_fit">() = [] {
+	std::vector<double> sizes{};
+	std::vector<double> n_log_n{};
+	std::vector<double> n_squared{};
+	for(double n = 256.0; n <= 65536.0; n *= 2.0)
+	{
+		sizes.emplace_back(n);
+		n_log_n.emplace_back(5000.0 + 2.0 * n * std::log2(n));
+		n_squared.emplace_back(20000.0 + 0.01 * n * n);
+	}
+
+	const auto n_log_n_fit = fit_complexity(sizes, n_log_n);
+	expect(complexity_to_string(n_log_n_fit.complexity)) == complexity_to_string(complexity_t::n_log_n);
+	expect(n_log_n_fit.rms) < 0.01;
+
+	const auto n_squared_fit = fit_complexity(sizes, n_squared);
+	expect(complexity_to_string(n_squared_fit.complexity)) == complexity_to_string(complexity_t::n_squared);
+	expect(n_squared_fit.rms) < 0.01;
+};
+
+// sweeps the input size, and fails when the timings fit worse than O(n)
+auto hash_benchmark = benchmark<"hash">(range<size_t, 1 << 10, 1 << 16, 2, range_multiply>{})
+						  .iterations(200)
+						  .complexity(complexity_t::n) = [](size_t count) {
+	std::uint64_t hash{0};
+	for(size_t i = 0; i < count; ++i) hash = hash * 31u + i;
+	do_not_optimize(hash);
+};
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <litmus/litmus.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/suite.hpp>
+
+#include <litmus/generator/corpus.hpp>
+#include <litmus/generator/file.hpp>
+
+using namespace litmus;
+using namespace litmus::generator;
+
+namespace
+{
+	// the data is checked in next to the examples, so they run from any working directory
+	auto data(const char* name) -> std::string
+	{
+		return (std::filesystem::path{__FILE__}.parent_path().parent_path() / "data" / name).string();
+	}
+
+	// little endian, as written by the generator of `squares.bin`
+	struct square_t
+	{
+		std::uint32_t value;
+		std::uint32_t square;
+	};
+
+	// the code the corpus suites test, they should hold for any input as a fuzzer can feed them anything
+	auto to_hex(std::span<const std::byte> bytes) -> std::string
+	{
+		constexpr std::string_view digits{"0123456789abcdef"};
+		std::string res{};
+		for(auto byte : bytes)
+		{
+			res += digits[static_cast<unsigned>(byte) >> 4u];
+			res += digits[static_cast<unsigned>(byte) & 0xfu];
+		}
+		return res;
+	}
+
+	auto from_hex(std::string_view text) -> std::vector<std::byte>
+	{
+		auto value = [](char digit) { return static_cast<unsigned>((digit <= '9') ? digit - '0' : digit - 'a' + 10); };
+		std::vector<std::byte> res{};
+		for(size_t i = 0; i + 1 < text.size(); i += 2)
+			res.emplace_back(static_cast<std::byte>((value(text[i]) << 4u) | value(text[i + 1])));
+		return res;
+	}
+
+	struct words_t
+	{
+		std::vector<std::string_view> words;
+		size_t size;
+	};
+} // namespace
+
+// splits the input on spaces and newlines, the words point into the input which outlives the suite invocation
+template <>
+struct litmus::bytes_decoder_t<words_t>
+{
+	auto operator()(std::span<const std::byte> bytes) const -> words_t
+	{
+		const std::string_view text{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+		words_t res{{}, text.size()};
+		for(size_t begin = text.find_first_not_of(" \n"); begin != std::string_view::npos;)
+		{
+			const auto end = std::min(text.find_first_of(" \n", begin), text.size());
+			res.words.emplace_back(text.substr(begin, end - begin));
+			begin = text.find_first_not_of(" \n", end);
+		}
+		return res;
+	}
+};
+
+auto lines_test = suite<"lines_generator">(lines<std::uint64_t>{data("squares.txt"), 16}) = [](std::uint64_t value) {
+	const auto root = static_cast<std::uint64_t>(std::llround(std::sqrt(static_cast<double>(value))));
+	expect(root * root) == value;
+};
+
+auto records_test = suite<"records_generator">(records<square_t>{data("squares.bin"), 4}) = [](square_t record) {
+	expect(record.value * record.value) == record.square;
+};
+
+// a file that can't be opened is a fatal result of the permutation, instead of an exception
+auto missing_file_test = suite<"missing_file">() = [] {
+	const auto error = lines<>{data("missing.txt")}.at(0).for_each([](std::string_view, size_t) {});
+	require(error.has_value()) == true;
+	expect(error->find("missing.txt")) != std::string::npos;
+};
+
+// every file of the corpus is a value, a build with LITMUS_FUZZ feeds the fuzzer input to the same suites
+auto hex_test = suite<"corpus_generator">(corpus<>{data("corpus")}) = [](std::span<const std::byte> bytes) {
+	const auto decoded = from_hex(to_hex(bytes));
+	require(decoded.size()) == bytes.size();
+	expect(std::equal(decoded.begin(), decoded.end(), bytes.begin())) == true;
+};
+
+auto words_test = suite<"corpus_decoder">(corpus<words_t>{data("corpus")}) = [](const words_t& input) {
+	size_t size{0};
+	for(auto word : input.words) size += word.size() + 1;
+	expect(size) <= input.size + 1;
+	expect(std::ranges::none_of(input.words, [](std::string_view word) { return word.empty(); })) == true;
+};
+
+auto missing_corpus_test = suite<"missing_corpus">() = [] {
+	const auto error = corpus<>{data("missing")}.at(0).for_each([](std::span<const std::byte>, size_t) {});
+	require(error.has_value()) == true;
+	expect(error->find("missing")) != std::string::npos;
+};
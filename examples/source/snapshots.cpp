@@ -0,0 +1,48 @@
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <litmus/litmus.hpp>
+
+#include <litmus/expect.hpp>
+#include <litmus/snapshot.hpp>
+#include <litmus/suite.hpp>
+
+using namespace litmus;
+
+namespace
+{
+	auto bytes(std::string_view text) -> std::span<const std::byte>
+	{
+		return {reinterpret_cast<const std::byte*>(text.data()), text.size()};
+	}
+} // namespace
+
+// the reference vectors of XXH64, the `.hash` files are only of use when they agree with other implementations
+auto snapshot_hash_test = suite<"snapshot_hash", "snapshots">() = [] {
+	expect(snapshot_hash(bytes(""))) == 0xef46db3751d8e999ull;
+	expect(snapshot_hash(bytes("abc"))) == 0x44bc2cf5ad770999ull;
+	expect(snapshot_hash(bytes("Nobody inspects the spammish repetition"))) == 0xfbcea83c8a378bf1ull;
+};
+
+// `snapshots/greeting.txt` is checked in together with its hash, so a match only hashes the output
+auto snapshot_test = suite<"snapshot", "snapshots">() = [] {
+	const std::string greeting{"hello snapshot\nsecond line\n"};
+	expect_snapshot(greeting, "greeting.txt");
+
+	// '--update-snapshots' would write the mismatch to the snapshot, so it's only shown in ordinary runs
+	if(config->update_snapshots) return;
+	const auto location = source_location::current();
+	const auto mismatch = compare_snapshot(bytes("hello snapshot\nthird line\n"), "greeting.txt", location);
+	expect(mismatch.pass) == false;
+	expect(mismatch.info.find("differs at byte 15 (line 2)")) != std::string::npos;
+	expect(std::filesystem::exists(mismatch.rhs + ".actual")) == true;
+
+	// which a later match removes again
+	expect(compare_snapshot(bytes(greeting), "greeting.txt", location).pass) == true;
+	expect(std::filesystem::exists(mismatch.rhs + ".actual")) == false;
+
+	expect(compare_snapshot(bytes(greeting), "missing.txt", location).pass) == false;
+};
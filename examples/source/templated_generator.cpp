@@ -1,9 +1,14 @@
+#include <cstdint>
+#include <limits>
+
 #include <litmus/litmus.hpp>
 
 #include <litmus/expect.hpp>
 #include <litmus/section.hpp>
 #include <litmus/suite.hpp>
 
+#include <litmus/generator/pairwise.hpp>
+#include <litmus/generator/random.hpp>
 #include <litmus/generator/range.hpp>
 
 using namespace litmus;
@@ -33,6 +38,16 @@ auto test4 = suite<"NTTP + template test">().templates<tpack<float, int>, vpack<
 	static_assert(value == 0 || value == 5);
 };
 
+using integers_t = tpack<std::int8_t, std::int16_t, std::int32_t>;
+auto test_where	 = suite<"filtered template matrix test">()
+					  .templates<integers_t, integers_t>()
+					  .where<[]<typename From, typename To>() { return sizeof(From) < sizeof(To); }>() =
+	[]<typename From, typename To>()
+{
+	static_assert(sizeof(From) < sizeof(To));
+	expect(static_cast<To>(std::numeric_limits<From>::max())) == std::numeric_limits<From>::max();
+};
+
 auto test5 =
 	suite<"generator + NTTP + template test">(range<size_t, 0, 3, 1>{}).templates<tpack<float, int>, vpack<0, 5>>() =
 		[]<typename T, typename value_t>(auto gen_value)
@@ -43,3 +58,18 @@ auto test5 =
 
 	expect(gen_value) == gen_value;
 };
+
+auto test6 = suite<"random generator test">(generator::random<std::vector<int>>{}, generator::random<int, 500>{}) =
+	[](std::vector<int> values, int value) {
+		values.push_back(value);
+		expect(values.back()) == value;
+		expect(std::count(std::begin(values), std::end(values), value)) > 0;
+	};
+
+auto test7 = suite<"pairwise generator test">(generator::pairwise(
+	range<int, 0, 9>{}, range<int, 10, 19>{}, array<'a', 'b', 'c'>{}, array<true, false>{})) =
+	[](int value0, int value1, char ch, bool flag) {
+		expect(value0) < value1;
+		expect(ch >= 'a' && ch <= 'c') == true;
+		std::ignore = flag;
+	};
@@ -0,0 +1,172 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <type_traits>
+
+#include <litmus/expect.hpp>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			distance between two floating point values in units in the last place, i.e. the amount of representable
+			values between them. NaN is infinitely far from everything, including itself.
+		*/
+		template <std::floating_point T>
+		[[nodiscard]] constexpr auto ulp_distance(T lhs, T rhs) noexcept -> std::uint64_t
+		{
+			if constexpr(sizeof(T) == sizeof(std::int32_t) || sizeof(T) == sizeof(std::int64_t))
+			{
+				using signed_t = std::conditional_t<sizeof(T) == sizeof(std::int32_t), std::int32_t, std::int64_t>;
+				using unsigned_t = std::make_unsigned_t<signed_t>;
+				if(std::isnan(lhs) || std::isnan(rhs)) return std::numeric_limits<std::uint64_t>::max();
+				if(lhs == rhs) return 0u;
+
+				// maps the sign-magnitude representation onto a monotonic integer line
+				constexpr auto ordered = [](T value) -> signed_t {
+					const auto bits = std::bit_cast<signed_t>(value);
+					return (bits < 0) ? std::numeric_limits<signed_t>::min() - bits : bits;
+				};
+				const auto a = ordered(lhs);
+				const auto b = ordered(rhs);
+				return (a > b) ? static_cast<unsigned_t>(a) - static_cast<unsigned_t>(b)
+							   : static_cast<unsigned_t>(b) - static_cast<unsigned_t>(a);
+			}
+			else
+			{
+				return ulp_distance(static_cast<double>(lhs), static_cast<double>(rhs));
+			}
+		}
+
+		/*
+			integers have no precision loss, the distance is their difference. It's taken modulo 2^64, which is exact
+			as the distance always fits, and unlike the difference in `T` can't overflow (e.g. INT_MAX and INT_MIN).
+		*/
+		template <typename T>
+			requires(std::is_integral_v<T>)
+		[[nodiscard]] constexpr auto ulp_distance(T lhs, T rhs) noexcept -> std::uint64_t
+		{
+			return (lhs > rhs) ? static_cast<std::uint64_t>(lhs) - static_cast<std::uint64_t>(rhs)
+							   : static_cast<std::uint64_t>(rhs) - static_cast<std::uint64_t>(lhs);
+		}
+
+		// shortest round trip representation, tolerances and errors are often too small for `std::to_string`
+		inline auto error_to_string(double value) -> std::string
+		{
+			char buffer[32]{};
+			const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+			return std::string{buffer, result.ptr};
+		}
+
+		template <typename T>
+		concept IsApproxRange = std::ranges::random_access_range<T> && std::ranges::sized_range<T>;
+	} // namespace internal
+
+	/*
+		tolerance aware comparison, `expect(x) == approx(y).ulps(4)`. Values compare equal when they are within
+		any of the configured tolerances, when none are configured 4 ulps are allowed. When `approx` wraps a range
+		it compares element wise through `expect_range`.
+	*/
+	template <typename T>
+	class approx_t
+	{
+	  public:
+		template <typename Y>
+		constexpr approx_t(Y&& value) noexcept : m_Value(std::forward<Y>(value))
+		{}
+
+		// allowed distance in units in the last place
+		[[nodiscard]] constexpr auto ulps(std::uint64_t value) const noexcept -> approx_t
+		{
+			auto copy   = *this;
+			copy.m_Ulps = value;
+			return copy;
+		}
+
+		// allowed difference relative to the largest of both magnitudes
+		[[nodiscard]] constexpr auto rel(double value) const noexcept -> approx_t
+		{
+			auto copy  = *this;
+			copy.m_Rel = value;
+			return copy;
+		}
+
+		// allowed absolute difference
+		[[nodiscard]] constexpr auto abs(double value) const noexcept -> approx_t
+		{
+			auto copy  = *this;
+			copy.m_Abs = value;
+			return copy;
+		}
+
+		[[nodiscard]] constexpr auto value() const noexcept -> const std::remove_cvref_t<T>& { return m_Value; }
+
+		template <typename L, typename R>
+		[[nodiscard]] constexpr auto within(const L& lhs, const R& rhs) const noexcept -> bool
+		{
+			using common_t = std::common_type_t<L, R>;
+			const auto a   = static_cast<common_t>(lhs);
+			const auto b   = static_cast<common_t>(rhs);
+			if(a == b) return true;
+
+			const auto difference = std::abs(static_cast<double>(a) - static_cast<double>(b));
+			if(m_Abs && difference <= *m_Abs) return true;
+			if(m_Rel &&
+			   difference <= *m_Rel * std::max(std::abs(static_cast<double>(a)), std::abs(static_cast<double>(b))))
+				return true;
+			if(m_Ulps || (!m_Abs && !m_Rel)) return ulp_distance(a, b) <= m_Ulps.value_or(4u);
+			return false;
+		}
+
+		[[nodiscard]] auto describe() const -> std::string
+		{
+			std::string res{};
+			if(m_Ulps) res += ", ulps: " + std::to_string(*m_Ulps);
+			if(m_Rel) res += ", rel: " + error_to_string(*m_Rel);
+			if(m_Abs) res += ", abs: " + error_to_string(*m_Abs);
+			if(res.empty()) res = ", ulps: 4";
+			if constexpr(IsApproxRange<std::remove_cvref_t<T>>)
+				return "approx(" + std::to_string(std::ranges::size(m_Value)) + " elements" + res + ")";
+			else
+				return "approx(" + to_string_fn(m_Value) + res + ")";
+		}
+
+	  private:
+		T m_Value;
+		std::optional<std::uint64_t> m_Ulps{};
+		std::optional<double> m_Rel{};
+		std::optional<double> m_Abs{};
+	};
+
+	// ranges are held by reference, they only need to outlive the expectation they are used in
+	template <typename T>
+	[[nodiscard]] constexpr auto approx(T&& value) noexcept
+	{
+		if constexpr(IsApproxRange<std::remove_cvref_t<T>>)
+			return approx_t<const std::remove_cvref_t<T>&>{value};
+		else
+			return approx_t<std::remove_cvref_t<T>>{value};
+	}
+
+	template <typename L, typename T>
+		requires(std::is_arithmetic_v<L> && std::is_arithmetic_v<std::remove_cvref_t<T>>)
+	[[nodiscard]] constexpr auto operator==(const L& lhs, const approx_t<T>& rhs) noexcept -> bool
+	{
+		return rhs.within(lhs, rhs.value());
+	}
+
+	template <typename T>
+	struct value_to_string_t<approx_t<T>>
+	{
+		std::string operator()(const approx_t<T>& value) const noexcept { return value.describe(); }
+	};
+} // namespace litmus
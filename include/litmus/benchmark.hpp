@@ -1,37 +1,479 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <litmus/details/exceptions.hpp>
 #include <litmus/details/fixed_string.hpp>
+#include <litmus/details/histogram.hpp>
+#include <litmus/details/runner.hpp>
+#include <litmus/details/scope.hpp>
+#include <litmus/details/source_location.hpp>
+#include <litmus/litmus.hpp>
+
+#ifndef LITMUS_BENCHMARK_ITERATIONS
+#define LITMUS_BENCHMARK_ITERATIONS 10000
+#endif
+
+#ifndef LITMUS_BENCHMARK_MAX_SECONDS
+#define LITMUS_BENCHMARK_MAX_SECONDS 1
+#endif
+
+#ifndef LITMUS_BENCHMARK_ATTEMPTS
+#define LITMUS_BENCHMARK_ATTEMPTS 3
+#endif
 
 namespace litmus
 {
+	// keeps the compiler from optimizing `value`, and the computation that produced it, away
+	template <typename T>
+	inline void do_not_optimize(T&& value) noexcept
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		const volatile void* sink = static_cast<const void*>(&value);
+		static_cast<void>(sink);
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+	}
+
+	// complexity classes benchmarks over input sizes are fitted to, in increasing order
+	enum class complexity_t
+	{
+		constant,
+		log_n,
+		n,
+		n_log_n,
+		n_squared,
+	};
+
 	inline namespace internal
 	{
+		struct benchmark_options_t
+		{
+			size_t iterations{LITMUS_BENCHMARK_ITERATIONS};
+			size_t warmup{LITMUS_BENCHMARK_ITERATIONS / 10};
+			// recording stops early once a permutation ran this long
+			std::chrono::nanoseconds max_time{std::chrono::seconds(LITMUS_BENCHMARK_MAX_SECONDS)};
+			// operations per second, 0 runs them back to back
+			double rate{0.0};
+			std::optional<complexity_t> complexity{};
+			// samples that are more dispersed than this are rejected and measured again, up to `attempts` times
+			double max_dispersion{0.25};
+			size_t attempts{LITMUS_BENCHMARK_ATTEMPTS};
+		};
+
+		// quartile coefficient of dispersion, (p75 - p25) / (p75 + p25), unlike the variance it ignores outliers
+		[[nodiscard]] inline auto dispersion(const histogram_t& histogram) noexcept -> double
+		{
+			const auto low	= static_cast<double>(histogram.percentile(25.0));
+			const auto high = static_cast<double>(histogram.percentile(75.0));
+			return (high + low > 0.0) ? (high - low) / (high + low) : 0.0;
+		}
+
+		inline auto complexity_to_string(complexity_t complexity) -> std::string
+		{
+			switch(complexity)
+			{
+			case complexity_t::constant:
+				return "O(1)";
+			case complexity_t::log_n:
+				return "O(log n)";
+			case complexity_t::n:
+				return "O(n)";
+			case complexity_t::n_log_n:
+				return "O(n log n)";
+			case complexity_t::n_squared:
+				return "O(n²)";
+			}
+			return {};
+		}
+
+		struct complexity_fit_t
+		{
+			complexity_t complexity;
+			// root mean square of the residuals, relative to the measured times
+			double rms;
+		};
+
+		/*
+			least squares fit of `times` to `overhead + coefficient * f(sizes)` for every complexity class, returns
+			the simplest class with the smallest error. The constant term absorbs the fixed cost of an invocation, so
+			it doesn't pull the small sizes towards a lower class. The residuals are relative, so the largest sizes
+			don't outweigh the others. Neither term is allowed to be negative, a class that only fits a decreasing
+			time (or a negative overhead) falls back to a single term.
+		*/
+		[[nodiscard]] inline auto fit_complexity(std::span<const double> sizes, std::span<const double> times)
+			-> complexity_fit_t
+		{
+			constexpr auto model = [](complexity_t complexity, double n) -> double {
+				switch(complexity)
+				{
+				case complexity_t::constant:
+					return 1.0;
+				case complexity_t::log_n:
+					return std::log2(n);
+				case complexity_t::n:
+					return n;
+				case complexity_t::n_log_n:
+					return n * std::log2(n);
+				case complexity_t::n_squared:
+					return n * n;
+				}
+				return 1.0;
+			};
+
+			// root mean square of the relative residuals of `overhead + coefficient * f(n)`
+			auto error = [&](complexity_t complexity, double overhead, double coefficient) {
+				double residuals{0.0};
+				for(size_t i = 0; i < sizes.size(); ++i)
+				{
+					const auto residual = 1.0 - (overhead + coefficient * model(complexity, sizes[i])) / times[i];
+					residuals += residual * residual;
+				}
+				return std::sqrt(residuals / static_cast<double>(sizes.size()));
+			};
+
+			// sums of the normal equations, weighted by 1 / time² as the residuals are relative
+			auto fit = [&](complexity_t complexity) -> double {
+				double w{0.0}, wf{0.0}, wff{0.0}, wt{0.0}, wft{0.0};
+				for(size_t i = 0; i < sizes.size(); ++i)
+				{
+					const auto weight = 1.0 / (times[i] * times[i]);
+					const auto f	  = model(complexity, sizes[i]);
+					w += weight;
+					wf += weight * f;
+					wff += weight * f * f;
+					wt += weight * times[i];
+					wft += weight * f * times[i];
+				}
+
+				const auto overhead_only = (w > 0.0) ? error(complexity, wt / w, 0.0) : 0.0;
+				if(complexity == complexity_t::constant) return overhead_only;
+				const auto coefficient_only = (wff > 0.0) ? error(complexity, 0.0, wft / wff) : overhead_only;
+
+				const auto determinant = w * wff - wf * wf;
+				if(determinant <= 0.0) return std::min(overhead_only, coefficient_only);
+				const auto overhead	   = (wff * wt - wf * wft) / determinant;
+				const auto coefficient = (w * wft - wf * wt) / determinant;
+				if(overhead < 0.0 || coefficient < 0.0) return std::min(overhead_only, coefficient_only);
+				return error(complexity, overhead, coefficient);
+			};
+
+			// a higher class only wins when it cuts the error by a tenth, so noise doesn't tip the scales towards it
+			complexity_fit_t res{complexity_t::constant, std::numeric_limits<double>::infinity()};
+			for(auto complexity : {complexity_t::constant, complexity_t::log_n, complexity_t::n, complexity_t::n_log_n,
+								   complexity_t::n_squared})
+			{
+				const auto rms = fit(complexity);
+				if(rms < res.rms * 0.9) res = {complexity, rms};
+			}
+			return res;
+		}
+
+		/*
+			latency benchmark, every invocation of the body is an operation of which the duration is recorded in a
+			histogram. The result is a test record with the percentiles as its measurement.
+		*/
+		template <typename Fn, typename Args>
+		class benchmark_permutations_t final : public permutations_t
+		{
+		  public:
+			benchmark_permutations_t(Fn fn, Args args, const char* name, const source_location& location,
+									 benchmark_options_t options)
+				: m_Fn(std::move(fn)), m_Args(std::move(args)), m_Name(name), m_Location(location),
+				  m_Options(options), m_Size(permutation_count(m_Args))
+			{}
+
+			[[nodiscard]] auto size() const noexcept -> size_t override { return m_Size; }
+
+			[[nodiscard]] auto run(size_t index) const -> test_result_t override
+			{
+				suite_context = {};
+				suite_context.output.scope_open(m_Name, {}, m_Location);
+				const auto measured = sample(permutation_at(m_Args, index));
+				suite_context.output.scope_close();
+				suite_context.output.sync();
+
+				suite_context.output.measurement = summary(measured);
+				if(!config->histograms.empty()) write(measured.histogram, index);
+				return suite_context.output;
+			}
+
+			// the last permutation of a sweep over input sizes that ran reports the fit of their medians
+			void conclude(std::span<test_result_t> results) const override
+			{
+				const auto fit = fit_sweep(results);
+				if(!fit) return;
+				auto last = std::find_if(std::rbegin(results), std::rend(results),
+										 [](const test_result_t& result) { return result.measurement.has_value(); });
+				last->measurement->complexity = complexity_to_string(fit->complexity);
+				last->measurement->rms		  = fit->rms;
+				if(m_Options.complexity)
+					last->append_result(complexity_to_string(fit->complexity),
+										complexity_to_string(*m_Options.complexity), "fitted complexity",
+										"expected complexity", test_result_t::expect_t::operation_t::less_equal,
+										fit->complexity <= *m_Options.complexity, false, {});
+			}
+
+			void start(size_t index, event_loop_t&, test_result_t& result) const override { result = run(index); }
+
+			[[nodiscard]] auto describe(size_t index) const -> std::vector<std::string> override
+			{
+				const auto values = permutation_at(m_Args, index);
+				return pack_to_string<std::tuple_size_v<std::remove_cvref_t<decltype(values)>>>(values);
+			}
+
+			[[nodiscard]] auto location() const noexcept -> const source_location& override { return m_Location; }
+
+		  private:
+			struct sample_t
+			{
+				histogram_t histogram{};
+				size_t operations{0};
+				size_t attempts{0};
+				double dispersion{std::numeric_limits<double>::infinity()};
+			};
+
+			// measures until a sample is stable enough, or keeps the least dispersed one when none of them were
+			[[nodiscard]] auto sample(const auto& values) const -> sample_t
+			{
+				sample_t res{};
+				for(size_t attempt = 1; attempt <= std::max<size_t>(m_Options.attempts, 1); ++attempt)
+				{
+					size_t operations{0};
+					auto histogram		 = measure(values, operations);
+					const auto dispersed = dispersion(histogram);
+					if(dispersed < res.dispersion) res = {std::move(histogram), operations, attempt, dispersed};
+					res.attempts = attempt;
+					if(res.dispersion <= m_Options.max_dispersion) break;
+				}
+				return res;
+			}
+
+			[[nodiscard]] auto measure(const auto& values, size_t& operations) const -> histogram_t
+			{
+				using clock = std::chrono::steady_clock;
+				const auto deadline = clock::now() + m_Options.max_time;
+				for(size_t i = 0; i < m_Options.warmup && clock::now() < deadline; ++i) std::apply(m_Fn, values);
+
+				const auto interval =
+					(m_Options.rate > 0.0) ? std::chrono::nanoseconds(static_cast<std::int64_t>(1e9 / m_Options.rate))
+										   : std::chrono::nanoseconds{0};
+				histogram_t histogram{};
+				auto next = clock::now();
+				for(; operations < m_Options.iterations && (operations == 0 || clock::now() < deadline); ++operations)
+				{
+					// a late operation does not move the schedule, the ones after it start back to back
+					if(interval.count() > 0)
+					{
+						std::this_thread::sleep_until(next);
+						next += interval;
+					}
+					const auto start = clock::now();
+					std::apply(m_Fn, values);
+					const auto elapsed = static_cast<std::uint64_t>(
+						std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+					histogram.record_corrected(elapsed, static_cast<std::uint64_t>(interval.count()));
+				}
+				return histogram;
+			}
+
+			/*
+				fits the median times to the input sizes, when the suite sweeps a single arithmetic argument and at
+				least 3 of its sizes ran
+			*/
+			[[nodiscard]] auto fit_sweep(std::span<const test_result_t> results) const
+				-> std::optional<complexity_fit_t>
+			{
+				return fit_sweep(results, std::make_index_sequence<std::tuple_size_v<Args>>{});
+			}
+
+			template <size_t... N>
+			[[nodiscard]] auto fit_sweep(std::span<const test_result_t> results, std::index_sequence<N...>) const
+				-> std::optional<complexity_fit_t>
+			{
+				std::optional<size_t> sweep{};
+				size_t varying{0};
+				((generator_size(std::get<N>(m_Args)) > 1 ? (sweep = N, ++varying) : 0u), ...);
+				if(varying != 1) return std::nullopt;
+
+				std::vector<double> sizes{};
+				std::vector<double> times{};
+				for(size_t i = 0; i < results.size(); ++i)
+				{
+					// filtered permutations did not run
+					if(!results[i].measurement) continue;
+					// unused when the benchmark has no arguments
+					[[maybe_unused]] const auto values = permutation_at(m_Args, i);
+					std::optional<double> size{};
+					((N == *sweep ? (size = argument_size(std::get<N>(values)), 0) : 0), ...);
+					const auto median = results[i].measurement->p50;
+					if(median <= 0.0 || !size || *size < 1.0) return std::nullopt;
+					sizes.emplace_back(*size);
+					times.emplace_back(median);
+				}
+				if(sizes.size() < 3) return std::nullopt;
+				return fit_complexity(sizes, times);
+			}
+
+			template <typename T>
+			[[nodiscard]] static auto argument_size(const T& value) -> std::optional<double>
+			{
+				if constexpr(std::is_arithmetic_v<T>)
+					return static_cast<double>(value);
+				else
+					return std::nullopt;
+			}
+
+			[[nodiscard]] auto summary(const sample_t& sample) const -> test_result_t::measurement_t
+			{
+				const auto& histogram = sample.histogram;
+				auto percentile		  = [&histogram](double p) { return static_cast<double>(histogram.percentile(p)); };
+				return {sample.operations,
+						histogram.mean(),
+						percentile(50.0),
+						percentile(90.0),
+						percentile(99.0),
+						percentile(99.9),
+						static_cast<double>(histogram.max()),
+						m_Options.rate,
+						(m_Options.rate > 0.0) ? histogram.count() : 0u,
+						sample.dispersion,
+						sample.attempts,
+						sample.dispersion > m_Options.max_dispersion};
+			}
+
+			// '--histograms <directory>', one file per permutation so they can be merged across runs
+			void write(const histogram_t& histogram, size_t index) const
+			{
+				const auto path = config->histograms + "/" + m_Name + "." + std::to_string(index) + ".hdr";
+				std::ofstream stream{path, std::ios::trunc};
+				if(except(!stream.is_open(), std::runtime_error("could not write the histogram to " + path))) return;
+				stream << histogram.export_text();
+			}
+
+			Fn m_Fn;
+			Args m_Args;
+			const char* m_Name;
+			source_location m_Location;
+			benchmark_options_t m_Options;
+			size_t m_Size;
+		};
+
 		template <typename... Ts>
-		struct benchmark_t
+		class benchmark_t
 		{
+		  public:
 			template <typename... Ys>
-			benchmark_t(const char* name, Ys&&... ys) : m_Name(name), m_Args(std::forward<Ys>(ys)...)
+			benchmark_t(const char* name, const source_location& location, Ys&&... ys)
+				: m_Name(name), m_Location(location), m_Args(std::forward<Ys>(ys)...)
 			{}
 
+			// recorded operations, after `warmup` unrecorded ones
+			auto iterations(size_t count) -> benchmark_t&
+			{
+				m_Options.iterations = count;
+				return *this;
+			}
+
+			auto warmup(size_t count) -> benchmark_t&
+			{
+				m_Options.warmup = count;
+				return *this;
+			}
+
+			// recording stops once a permutation ran for `duration` (after at least one operation)
+			auto max_time(std::chrono::nanoseconds duration) -> benchmark_t&
+			{
+				m_Options.max_time = duration;
+				return *this;
+			}
+
+			// fails when the timings over the input sizes fit a higher complexity class than `expected`
+			auto complexity(complexity_t expected) -> benchmark_t&
+			{
+				m_Options.complexity = expected;
+				return *this;
+			}
+
+			/*
+				rejects samples of which the quartile coefficient of dispersion exceeds `max`, and measures again up
+				to `attempts` times in total
+			*/
+			auto stability(double max, size_t attempts = LITMUS_BENCHMARK_ATTEMPTS) -> benchmark_t&
+			{
+				m_Options.max_dispersion = max;
+				m_Options.attempts		 = attempts;
+				return *this;
+			}
+
+			// starts an operation `per_second` times a second, and corrects the histogram for coordinated omission
+			auto rate(double per_second) -> benchmark_t&
+			{
+				m_Options.rate = per_second;
+				return *this;
+			}
+
 			template <typename Fn>
-			requires(requires(Fn fn, std::tuple<Ts...> values) { std::apply(fn, values); }) auto operator=(Fn&& fn)
-				-> benchmark_t
+				requires(requires(Fn fn, decltype(permutation_at(std::declval<const std::tuple<Ts...>&>(), 0)) values) {
+					std::apply(fn, values);
+				})
+			auto operator=(Fn&& fn) -> benchmark_t&
 			{
-				std::apply(fn, m_Args);
+				if(m_HasRun) return *this;
+				using permutations = benchmark_permutations_t<std::remove_cvref_t<Fn>, std::tuple<Ts...>>;
+				runner.benchmark(m_Name, std::make_unique<const permutations>(std::forward<Fn>(fn), m_Args, m_Name,
+																			  m_Location, m_Options));
+				m_HasRun = true;
 				return *this;
 			}
 
+			constexpr operator bool() const noexcept { return m_HasRun; }
+
+		  private:
 			const char* m_Name;
+			source_location m_Location;
 			std::tuple<Ts...> m_Args;
+			benchmark_options_t m_Options{};
+			bool m_HasRun{false};
 		};
-
 	} // namespace internal
 
+	template <fixed_string Name>
+	[[nodiscard]] auto benchmark(const source_location& location = source_location::current()) -> benchmark_t<>
+	{
+		return benchmark_t<>{Name, location};
+	}
+
+	template <fixed_string Name, typename T0>
+	[[nodiscard]] auto benchmark(T0&& v0, const source_location& location = source_location::current())
+		-> benchmark_t<std::remove_cvref_t<T0>>
+	{
+		return benchmark_t<std::remove_cvref_t<T0>>{Name, location, std::forward<T0>(v0)};
+	}
 
-	template <fixed_string Name, typename... Ts>
-	constexpr auto benchmark(Ts&&... args) -> benchmark_t<Ts...>
+	template <fixed_string Name, typename T0, typename T1>
+	[[nodiscard]] auto benchmark(T0&& v0, T1&& v1, const source_location& location = source_location::current())
+		-> benchmark_t<std::remove_cvref_t<T0>, std::remove_cvref_t<T1>>
 	{
-		return benchmark_t<Ts...>{Name, std::forward<Ts>(args)...};
+		return benchmark_t<std::remove_cvref_t<T0>, std::remove_cvref_t<T1>>{Name, location, std::forward<T0>(v0),
+																			  std::forward<T1>(v1)};
 	}
-} // namespace litmus
\ No newline at end of file
+} // namespace litmus
@@ -1,5 +1,7 @@
 #pragma once
 #include <cstddef>
+#include <memory>
+#include <litmus/details/mpsc_queue.hpp>
 #include <litmus/details/test_result.hpp>
 
 namespace litmus
@@ -23,5 +25,14 @@ namespace litmus
 			test_id_t working_stack{};
 			bool bail{false};
 		} suite_context;
+
+		// set on threads that record their expects in the suite of another thread, see `attach_context`
+		struct remote_target_t
+		{
+			std::shared_ptr<mpsc_queue_t<test_result_t::expect_t>> queue{};
+			size_t scope{0};
+		};
+
+		extern thread_local remote_target_t remote_target;
 	} // namespace internal
 } // namespace litmus
\ No newline at end of file
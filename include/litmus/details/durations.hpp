@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			durations of the permutations of earlier runs ('--durations <file>'), used to estimate what a run will
+			cost. Permutations are identified by their suite, template arguments and ordinal within them, so the
+			history stays valid as long as the registrations don't change.
+		*/
+		class duration_history_t
+		{
+		  public:
+			duration_history_t() = default;
+
+			// reads the history from `filename`, a missing file is an empty history
+			explicit duration_history_t(const std::string& filename);
+
+			// writes the history to `filename`, replacing the previous one as a whole
+			void save(const std::string& filename) const;
+
+			void record(std::string key, std::chrono::microseconds duration);
+			[[nodiscard]] auto find(const std::string& key) const -> std::optional<std::chrono::microseconds>;
+
+			[[nodiscard]] auto empty() const noexcept -> bool { return m_Durations.empty(); }
+
+			// "<suite>\t<template, ...>\t<ordinal>"
+			[[nodiscard]] static auto key(std::string_view suite, const std::vector<std::string>& templates,
+										  size_t ordinal) -> std::string;
+
+		  private:
+			std::unordered_map<std::string, std::chrono::microseconds> m_Durations{};
+		};
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,95 @@
+#pragma once
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <litmus/details/context.hpp>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			drives coroutine suites on the thread that runs them. Every spawned coroutine (root) owns a suite context
+			which is swapped in whenever the loop resumes it, so suites that are waiting on timers or file
+			descriptors interleave on a single thread without mixing their results.
+		*/
+		class event_loop_t
+		{
+		  public:
+			using clock = std::chrono::steady_clock;
+
+			struct root_t
+			{
+				std::coroutine_handle<> handle{};
+				// borrowed roots run inside the suite context of the coroutine that waits on them
+				bool borrowed{false};
+				bool done{false};
+				std::exception_ptr exception{};
+				suite_context_t context{};
+			};
+
+			event_loop_t() = default;
+			~event_loop_t();
+			event_loop_t(const event_loop_t&) = delete;
+			event_loop_t(event_loop_t&&)	  = delete;
+
+			auto operator=(const event_loop_t&) -> event_loop_t& = delete;
+			auto operator=(event_loop_t&&) -> event_loop_t&		 = delete;
+
+			// the loop that is currently running on this thread, if any
+			[[nodiscard]] static auto current() noexcept -> event_loop_t*;
+
+			// takes ownership of the (suspended) coroutine, it starts when the loop runs
+			auto spawn(std::coroutine_handle<> handle) -> root_t&;
+
+			// runs until every spawned coroutine completed, rethrows exceptions they did not handle
+			void run();
+
+			/*
+				runs until the borrowed `root` completes, only resuming `root` in the meantime (so nested waits can
+				never pile up). Used to wait on a coroutine from synchronous code that is itself running on the loop.
+			*/
+			void run_until(root_t& root);
+
+			void resume_at(clock::time_point deadline, std::coroutine_handle<> handle, root_t* root);
+
+			// resumes `handle` once `fd` is readable (or writable), any amount of coroutines can wait on the same `fd`
+			void resume_when(int fd, bool write, std::coroutine_handle<> handle, root_t* root);
+
+		  private:
+			struct waiter_t
+			{
+				std::coroutine_handle<> handle{};
+				root_t* root{nullptr};
+			};
+
+			// a coroutine waiting on a file descriptor, several can wait on the same one (e.g. a reader and a writer)
+			struct watcher_t
+			{
+				waiter_t waiter{};
+				bool write{false};
+			};
+
+			/*
+				resumes the ready coroutines of `only` (or all when null), waits for events when there are none.
+				Returns false when nothing is ready and there is nothing to wait on.
+			*/
+			[[nodiscard]] auto step(root_t* only) -> bool;
+			void resume(const waiter_t& waiter);
+			void wait(clock::time_point until);
+
+			std::unordered_map<root_t*, std::unique_ptr<root_t>> m_Roots{};
+			std::vector<root_t*> m_Finished{};
+			std::deque<waiter_t> m_Ready{};
+			std::multimap<clock::time_point, waiter_t> m_Timers{};
+			std::unordered_map<int, std::vector<watcher_t>> m_Watchers{};
+			int m_Poll{-1};
+		};
+	} // namespace internal
+} // namespace litmus
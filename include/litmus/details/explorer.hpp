@@ -0,0 +1,109 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <litmus/details/random.hpp>
+
+#ifndef LITMUS_EXPLORE_MAX_STEPS
+#define LITMUS_EXPLORE_MAX_STEPS 100000
+#endif
+
+namespace litmus
+{
+	enum class explore_strategy_t
+	{
+		random,		// every yield point switches to a random runnable thread, seeded by '--seed'
+		exhaustive, // depth first over every interleaving, until the schedule budget runs out
+	};
+
+	inline namespace internal
+	{
+		/*
+			cooperative scheduler of a single explored schedule. The threads it spawns are real threads, but only
+			one of them runs at a time, and it only hands over at yield points (explored atomics, `explore::yield`).
+			As the choice at every yield point is recorded the interleaving is fully determined by the strategy and
+			the choices that came before, which is what makes failing schedules replayable.
+		*/
+		class explorer_t
+		{
+		  public:
+			struct decision_t
+			{
+				size_t chosen;
+				size_t options;
+				size_t thread;
+			};
+
+			// `prefix` holds the choices (as option index) that are replayed before the strategy takes over
+			explorer_t(explore_strategy_t strategy, std::uint64_t seed, std::vector<size_t> prefix = {});
+			~explorer_t() = default;
+			explorer_t(const explorer_t&) = delete;
+			explorer_t(explorer_t&&)	  = delete;
+
+			auto operator=(const explorer_t&) -> explorer_t& = delete;
+			auto operator=(explorer_t&&) -> explorer_t&		 = delete;
+
+			// the explorer the calling thread is scheduled by, if any
+			[[nodiscard]] static auto current() noexcept -> explorer_t*;
+
+			// runs `body` as thread 0 on the calling thread, and joins every thread it spawned
+			void run(const std::function<void()>& body);
+
+			// spawns a thread that is scheduled by this explorer, returns its index
+			auto spawn(std::function<void()> fn) -> size_t;
+
+			// hands over to the thread the strategy picks, which may be the calling thread itself
+			void yield();
+
+			void join(size_t thread);
+
+			[[nodiscard]] auto decisions() const noexcept -> const std::vector<decision_t>& { return m_Decisions; }
+			[[nodiscard]] auto steps() const noexcept -> size_t { return m_Steps; }
+			[[nodiscard]] auto exceeded() const noexcept -> bool { return m_Steps > LITMUS_EXPLORE_MAX_STEPS; }
+
+			// the interleaving as `thread:yield points` segments, e.g. "0:3 1:1 0:2"
+			[[nodiscard]] auto describe() const -> std::string;
+
+			// the prefix of the next schedule of a depth first exploration, none when every schedule was visited
+			[[nodiscard]] static auto next_prefix(const std::vector<decision_t>& decisions)
+				-> std::optional<std::vector<size_t>>;
+
+		  private:
+			struct thread_t
+			{
+				std::thread handle{};
+				bool done{false};
+				size_t joining{static_cast<size_t>(-1)};
+			};
+
+			[[nodiscard]] auto runnable(size_t index) const noexcept -> bool;
+			// picks the next thread to run, the lock has to be held
+			[[nodiscard]] auto pick(size_t self) -> size_t;
+			// hands the turn to `next` and waits until the turn comes back to `self`
+			void switch_to(std::unique_lock<std::mutex>& lock, size_t self, size_t next);
+			void finish(size_t self);
+
+			explore_strategy_t m_Strategy;
+			prng_t m_Prng;
+			std::vector<size_t> m_Prefix;
+			std::vector<decision_t> m_Decisions{};
+			// consecutive picks of the same thread, as (thread, count)
+			std::vector<std::pair<size_t, size_t>> m_Trace{};
+			size_t m_Steps{0};
+
+			std::mutex m_Lock{};
+			std::condition_variable m_Turn{};
+			std::deque<thread_t> m_Threads{};
+			size_t m_Running{0};
+		};
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,40 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		struct test_result_t;
+
+		/*
+			'--fork-sections' execution strategy. Instead of replaying the suite from the start for every section
+			path, every section that is about to run is executed in a forked (copy-on-write) child, while the parent
+			skips it and continues with its siblings. Every process that did not fork a child executed a complete
+			path, and sends its results to the runner.
+		*/
+		namespace fork
+		{
+			// true when the strategy is available on this platform
+			[[nodiscard]] auto supported() noexcept -> bool;
+
+			// true while executing the body of `run`, i.e. inside a forked process
+			[[nodiscard]] auto active() noexcept -> bool;
+
+			/*
+				runs `body` in a forked process, returns the results of every executed section path in the order
+				the replay strategy would have executed them. `body` should leave its results in
+				`suite_context.output`. When a forked process terminates abnormally a fatal expect is added to
+				the returned results.
+			*/
+			[[nodiscard]] auto run(const std::function<void()>& body) -> std::vector<test_result_t>;
+
+			// forks for the section that is about to run, returns true in the child (which runs it).
+			[[nodiscard]] auto section() noexcept -> bool;
+
+			// flushes the standard streams before forking, anything still buffered would be written by both processes
+			void flush_streams();
+		} // namespace fork
+	} // namespace internal
+} // namespace litmus
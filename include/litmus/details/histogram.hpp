@@ -0,0 +1,189 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef LITMUS_HISTOGRAM_PRECISION
+// sub bucket bits of the histogram, 7 bits gives 64 sub buckets per power of two, so a recorded value is at most
+// about 1.6% away from its bucket
+#define LITMUS_HISTOGRAM_PRECISION 7
+#endif
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			high dynamic range histogram of (nanosecond) values. Buckets are linear up to 2^precision, and from there
+			on every power of two is split in 2^(precision - 1) sub buckets, so the relative error stays constant
+			from nanoseconds to minutes in a few thousand counters. Histograms merge by adding their counts, and can
+			be exported as text to be merged across runs.
+		*/
+		class histogram_t
+		{
+			static constexpr std::uint32_t precision{LITMUS_HISTOGRAM_PRECISION};
+			static constexpr std::uint64_t sub_buckets{std::uint64_t{1} << precision};
+			static constexpr std::uint64_t half_buckets{sub_buckets / 2};
+
+		  public:
+			histogram_t() : m_Counts(bucket_count(), 0u) {}
+
+			void record(std::uint64_t value, std::uint64_t count = 1u) noexcept
+			{
+				m_Counts[index_of(value)] += count;
+				m_Total += count;
+				m_Sum += static_cast<double>(value) * static_cast<double>(count);
+				m_Min = std::min(m_Min, value);
+				m_Max = std::max(m_Max, value);
+			}
+
+			/*
+				records `value` of an operation that should have started every `interval`. When it took longer, the
+				operations that could not start in the meantime are recorded as well (with the latency they would
+				have seen), which corrects the coordinated omission of fixed rate load generators.
+			*/
+			void record_corrected(std::uint64_t value, std::uint64_t interval) noexcept
+			{
+				record(value);
+				if(interval == 0u || value <= interval) return;
+				for(auto missing = value - interval; missing >= interval; missing -= interval) record(missing);
+			}
+
+			void merge(const histogram_t& other) noexcept
+			{
+				for(size_t i = 0; i < m_Counts.size(); ++i) m_Counts[i] += other.m_Counts[i];
+				m_Total += other.m_Total;
+				m_Sum += other.m_Sum;
+				m_Min = std::min(m_Min, other.m_Min);
+				m_Max = std::max(m_Max, other.m_Max);
+			}
+
+			// the highest value `percentile` (0-100) of the recorded values are at or below
+			[[nodiscard]] auto percentile(double percentile) const noexcept -> std::uint64_t
+			{
+				if(m_Total == 0u) return 0u;
+				const auto target = std::max<std::uint64_t>(
+					1u, static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+															  static_cast<double>(m_Total))));
+				std::uint64_t seen{0};
+				for(size_t i = 0; i < m_Counts.size(); ++i)
+				{
+					seen += m_Counts[i];
+					if(seen >= target) return std::clamp(highest_of(i), m_Min, m_Max);
+				}
+				return m_Max;
+			}
+
+			[[nodiscard]] auto count() const noexcept -> std::uint64_t { return m_Total; }
+			[[nodiscard]] auto min() const noexcept -> std::uint64_t { return (m_Total == 0u) ? 0u : m_Min; }
+			[[nodiscard]] auto max() const noexcept -> std::uint64_t { return m_Max; }
+			[[nodiscard]] auto mean() const noexcept -> double
+			{
+				return (m_Total == 0u) ? 0.0 : m_Sum / static_cast<double>(m_Total);
+			}
+
+			/*
+				"litmus-histogram <precision> <count> <sum> <min> <max>" followed by a "<bucket> <count>" line per
+				non-empty bucket.
+			*/
+			[[nodiscard]] auto export_text() const -> std::string
+			{
+				std::string res{"litmus-histogram " + std::to_string(precision) + " " + std::to_string(m_Total) + " " +
+								std::to_string(static_cast<std::uint64_t>(m_Sum)) + " " + std::to_string(min()) + " " +
+								std::to_string(m_Max) + "\n"};
+				for(size_t i = 0; i < m_Counts.size(); ++i)
+				{
+					if(m_Counts[i] == 0u) continue;
+					res += std::to_string(i) + " " + std::to_string(m_Counts[i]) + "\n";
+				}
+				return res;
+			}
+
+			// parses the output of `export_text`, none when the text is malformed or of a different precision
+			[[nodiscard]] static auto import_text(std::string_view text) -> std::optional<histogram_t>
+			{
+				constexpr std::string_view header{"litmus-histogram "};
+				if(!text.starts_with(header)) return std::nullopt;
+				text.remove_prefix(header.size());
+
+				auto next = [&text](std::uint64_t& value) -> bool {
+					while(!text.empty() && (text.front() == ' ' || text.front() == '\n')) text.remove_prefix(1);
+					const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+					if(result.ec != std::errc{}) return false;
+					text.remove_prefix(static_cast<size_t>(result.ptr - text.data()));
+					return true;
+				};
+
+				histogram_t res{};
+				std::uint64_t file_precision{0};
+				std::uint64_t sum{0};
+				if(!next(file_precision) || file_precision != precision || !next(res.m_Total) || !next(sum) ||
+				   !next(res.m_Min) || !next(res.m_Max))
+					return std::nullopt;
+				res.m_Sum = static_cast<double>(sum);
+				if(res.m_Total == 0u) res.m_Min = std::numeric_limits<std::uint64_t>::max();
+
+				std::uint64_t bucket{0};
+				std::uint64_t count{0};
+				while(next(bucket))
+				{
+					if(!next(count) || bucket >= res.m_Counts.size()) return std::nullopt;
+					res.m_Counts[bucket] = count;
+				}
+				return res;
+			}
+
+		  private:
+			[[nodiscard]] static constexpr auto bucket_count() noexcept -> size_t
+			{
+				return static_cast<size_t>((64u - precision + 2u) * half_buckets);
+			}
+
+			[[nodiscard]] static constexpr auto index_of(std::uint64_t value) noexcept -> size_t
+			{
+				if(value < sub_buckets) return static_cast<size_t>(value);
+				const auto bucket = static_cast<std::uint64_t>(std::bit_width(value)) - precision;
+				return static_cast<size_t>(bucket * half_buckets + (value >> bucket));
+			}
+
+			[[nodiscard]] static constexpr auto highest_of(size_t index) noexcept -> std::uint64_t
+			{
+				if(index < sub_buckets) return index;
+				const auto bucket = index / half_buckets - 1u;
+				const auto sub	  = index - bucket * half_buckets;
+				return ((sub + 1u) << bucket) - 1u;
+			}
+
+			std::vector<std::uint64_t> m_Counts;
+			std::uint64_t m_Total{0};
+			double m_Sum{0.0};
+			std::uint64_t m_Min{std::numeric_limits<std::uint64_t>::max()};
+			std::uint64_t m_Max{0};
+		};
+
+		// "850ns", "12.3μs", "4.1ms", "2.0s"
+		inline auto nanoseconds_to_string(double value) -> std::string
+		{
+			constexpr std::string_view units[]{"ns", "μs", "ms", "s"};
+			size_t unit{0};
+			while(value >= 1000.0 && unit + 1 < std::size(units))
+			{
+				value /= 1000.0;
+				++unit;
+			}
+			char buffer[32]{};
+			const auto result = (unit == 0) ? std::to_chars(std::begin(buffer), std::end(buffer),
+														   static_cast<std::uint64_t>(std::llround(value)))
+											: std::to_chars(std::begin(buffer), std::end(buffer), value,
+															std::chars_format::fixed, 1);
+			return std::string{buffer, result.ptr} + std::string{units[unit]};
+		}
+	} // namespace internal
+} // namespace litmus
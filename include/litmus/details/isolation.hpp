@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			keeps benchmarks on a single core, so they are not migrated (and their caches are not lost) while they
+			are measured. The previous affinity of the calling thread is restored when it goes out of scope.
+		*/
+		class cpu_pin_t
+		{
+		  public:
+			// pins to `cpu`, or to the core the calling thread currently runs on
+			explicit cpu_pin_t(std::optional<size_t> cpu = std::nullopt);
+			~cpu_pin_t();
+
+			cpu_pin_t(cpu_pin_t const&) = delete;
+			cpu_pin_t(cpu_pin_t&&)		= delete;
+
+			auto operator=(cpu_pin_t const&) -> cpu_pin_t& = delete;
+			auto operator=(cpu_pin_t&&) -> cpu_pin_t&		= delete;
+
+			// the core the thread is pinned to, none when pinning failed or is not supported on this platform
+			[[nodiscard]] auto cpu() const noexcept -> std::optional<size_t> { return m_Cpu; }
+
+		  private:
+			std::optional<size_t> m_Cpu{};
+			// the cores the thread was allowed to run on before it was pinned
+			std::vector<size_t> m_Previous{};
+		};
+
+		/*
+			reasons timings taken on this machine could be unstable: frequency governors other than 'performance'
+			(of `cpu`, or of every core), frequency boost, and a load average that shows other processes competing
+			for the cpu.
+		*/
+		[[nodiscard]] auto noisy_environment(std::optional<size_t> cpu) -> std::vector<std::string>;
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,19 @@
+#pragma once
+#include <ostream>
+
+#include <litmus/litmus.hpp>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		class duration_history_t;
+
+		/*
+			'--list', writes every permutation of every suite and benchmark with its parameters, categories and
+			location to `stream` without running anything. When `history` holds durations of earlier runs every
+			permutation is given an estimated cost, the duration it had before or the mean of its registration.
+		*/
+		void list_permutations(std::ostream& stream, list_format_t format, const duration_history_t* history);
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+#include <system_error>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			read-only memory mapping of an entire file, pages are only read in when they are touched so the
+			memory footprint does not depend on the size of the file.
+		*/
+		class mapped_file_t
+		{
+		  public:
+			mapped_file_t() = default;
+			mapped_file_t(const std::string& filename);
+			// sets `error` instead of throwing when the file can't be opened or mapped, the mapping is empty then
+			mapped_file_t(const std::string& filename, std::error_code& error) noexcept;
+			~mapped_file_t();
+
+			mapped_file_t(mapped_file_t const&) = delete;
+			mapped_file_t(mapped_file_t&& other) noexcept;
+
+			auto operator=(mapped_file_t const&) -> mapped_file_t& = delete;
+			auto operator=(mapped_file_t&& other) noexcept -> mapped_file_t&;
+
+			[[nodiscard]] auto data() const noexcept -> const std::byte* { return m_Data; }
+			[[nodiscard]] auto size() const noexcept -> size_t { return m_Size; }
+			[[nodiscard]] auto empty() const noexcept -> bool { return m_Size == 0; }
+
+			[[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte> { return {m_Data, m_Size}; }
+
+			// hint that the given range will be read front to back
+			void sequential(size_t offset, size_t size) const noexcept;
+
+		  private:
+			void close() noexcept;
+
+			const std::byte* m_Data{nullptr};
+			size_t m_Size{0};
+#if defined(_WIN32)
+			void* m_File{nullptr};
+			void* m_Mapping{nullptr};
+#endif
+		};
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			lock-free multi producer, single consumer queue. Producers push onto an intrusive stack, the consumer
+			takes the entire stack at once, so there is no ABA problem to guard against.
+		*/
+		template <typename T>
+		class mpsc_queue_t
+		{
+			struct node_t
+			{
+				T value;
+				node_t* next{nullptr};
+			};
+
+		  public:
+			mpsc_queue_t() = default;
+			~mpsc_queue_t() { std::ignore = take(); }
+			mpsc_queue_t(const mpsc_queue_t&) = delete;
+			mpsc_queue_t(mpsc_queue_t&&)	  = delete;
+
+			auto operator=(const mpsc_queue_t&) -> mpsc_queue_t& = delete;
+			auto operator=(mpsc_queue_t&&) -> mpsc_queue_t&		 = delete;
+
+			// safe to call from any thread
+			void push(T value)
+			{
+				auto* node = new node_t{std::move(value), m_Head.load(std::memory_order_relaxed)};
+				while(!m_Head.compare_exchange_weak(node->next, node, std::memory_order_release,
+													std::memory_order_relaxed))
+				{}
+			}
+
+			// returns everything pushed so far in the order it was pushed, only the consumer may call this
+			[[nodiscard]] auto take() -> std::vector<T>
+			{
+				std::vector<T> res{};
+				for(auto* node = m_Head.exchange(nullptr, std::memory_order_acquire); node != nullptr;)
+				{
+					res.emplace_back(std::move(node->value));
+					delete std::exchange(node, node->next);
+				}
+				std::reverse(std::begin(res), std::end(res));
+				return res;
+			}
+
+			[[nodiscard]] auto empty() const noexcept -> bool
+			{
+				return m_Head.load(std::memory_order_acquire) == nullptr;
+			}
+
+		  private:
+			std::atomic<node_t*> m_Head{nullptr};
+		};
+	} // namespace internal
+} // namespace litmus
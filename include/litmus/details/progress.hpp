@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		struct test_result_t;
+		class duration_history_t;
+
+		/*
+			'--progress', reports how far a run is while it's running. The threads that run the suites only bump
+			relaxed counters, once per permutation, and a reporter thread samples them at a fixed interval. On a
+			terminal a single status line is redrawn in place, otherwise a line is logged every interval.
+		*/
+		class progress_reporter_t
+		{
+		  public:
+			/*
+				`expected` is what the run is estimated to cost from the durations of earlier runs, the remaining time
+				is extrapolated from the finished permutations otherwise
+			*/
+			progress_reporter_t(std::chrono::milliseconds interval, size_t permutations, size_t suites,
+								std::optional<std::chrono::microseconds> expected);
+			~progress_reporter_t();
+
+			progress_reporter_t(const progress_reporter_t&)					   = delete;
+			progress_reporter_t(progress_reporter_t&&)						   = delete;
+			auto operator=(const progress_reporter_t&) -> progress_reporter_t& = delete;
+			auto operator=(progress_reporter_t&&) -> progress_reporter_t&	   = delete;
+
+			void permutation_done(const test_result_t& result) noexcept;
+			void suite_done() noexcept { m_Suites.fetch_add(1, std::memory_order_relaxed); }
+
+			// clears the status line, it's not drawn again until the lock is released
+			[[nodiscard]] auto pause() -> std::unique_lock<std::mutex>;
+
+			// true when the status line can be redrawn in place
+			[[nodiscard]] static auto terminal() noexcept -> bool;
+
+			/*
+				held around `fork()` ('--fork-sections', '--workers'), the reporter thread doesn't write while it's
+				held, so a child never inherits a standard stream that is locked in the middle of a write
+			*/
+			[[nodiscard]] static auto fork_guard() -> std::unique_lock<std::mutex>;
+
+		  private:
+			void report();
+			[[nodiscard]] auto status() const -> std::string;
+
+			const std::chrono::steady_clock::time_point m_Start{std::chrono::steady_clock::now()};
+			const std::chrono::milliseconds m_Interval;
+			const size_t m_TotalPermutations;
+			const size_t m_TotalSuites;
+			const std::optional<std::chrono::microseconds> m_Expected;
+			const bool m_Terminal{terminal()};
+
+			std::atomic<size_t> m_Permutations{0};
+			std::atomic<size_t> m_Suites{0};
+			std::atomic<size_t> m_Expects{0};
+			std::atomic<size_t> m_Failures{0};
+			std::atomic<std::int64_t> m_Microseconds{0};
+
+			std::mutex m_Mutex{};
+			std::condition_variable m_Wake{};
+			bool m_Stop{false};
+			bool m_Drawn{false};
+			std::thread m_Thread{};
+		};
+
+		/*
+			estimated duration of the registered tests (and benchmarks) from the durations of earlier runs, the
+			permutations without a recorded duration are assumed to take the mean of the others
+		*/
+		[[nodiscard]] auto expected_duration(const duration_history_t& history, bool tests, bool benchmarks)
+			-> std::optional<std::chrono::microseconds>;
+	} // namespace internal
+} // namespace litmus
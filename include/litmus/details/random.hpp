@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		[[nodiscard]] constexpr auto splitmix64(std::uint64_t& state) noexcept -> std::uint64_t
+		{
+			std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+			z				= (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z				= (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+
+		// FNV-1a, used to derive stable per-suite streams from the run seed.
+		[[nodiscard]] constexpr auto hash_string(std::string_view str,
+												 std::uint64_t hash = 0xcbf29ce484222325ull) noexcept -> std::uint64_t
+		{
+			for(auto ch : str)
+			{
+				hash ^= static_cast<std::uint8_t>(ch);
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+		/*
+			xoshiro256** generator, satisfies UniformRandomBitGenerator so it can be used with the <random>
+			distributions as well.
+		*/
+		class prng_t
+		{
+		  public:
+			using result_type = std::uint64_t;
+
+			constexpr prng_t(std::uint64_t seed = 0u) noexcept { this->seed(seed); }
+
+			constexpr void seed(std::uint64_t seed) noexcept
+			{
+				for(auto& state : m_State) state = splitmix64(seed);
+			}
+
+			[[nodiscard]] static constexpr auto min() noexcept -> result_type { return 0u; }
+			[[nodiscard]] static constexpr auto max() noexcept -> result_type
+			{
+				return std::numeric_limits<result_type>::max();
+			}
+
+			constexpr auto operator()() noexcept -> result_type
+			{
+				const auto result = rotl(m_State[1] * 5u, 7) * 9u;
+				const auto t	  = m_State[1] << 17;
+
+				m_State[2] ^= m_State[0];
+				m_State[3] ^= m_State[1];
+				m_State[1] ^= m_State[2];
+				m_State[0] ^= m_State[3];
+				m_State[2] ^= t;
+				m_State[3] = rotl(m_State[3], 45);
+
+				return result;
+			}
+
+			// unbiased integer in [0, bound), bound of 0 returns the full 64 bit range
+			constexpr auto below(std::uint64_t bound) noexcept -> std::uint64_t
+			{
+				if(bound == 0u) return (*this)();
+				const auto threshold = (0u - bound) % bound;
+				while(true)
+				{
+					const auto value = (*this)();
+					if(value >= threshold) return value % bound;
+				}
+			}
+
+			// uniform double in [0, 1)
+			constexpr auto unit() noexcept -> double
+			{
+				return static_cast<double>((*this)() >> 11) * (1.0 / static_cast<double>(1ull << 53));
+			}
+
+			constexpr auto chance(std::uint64_t one_in) noexcept -> bool { return below(one_in) == 0u; }
+
+		  private:
+			static constexpr auto rotl(std::uint64_t x, int k) noexcept -> std::uint64_t
+			{
+				return (x << k) | (x >> (64 - k));
+			}
+
+			std::array<std::uint64_t, 4> m_State{};
+		};
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <litmus/details/runner.hpp>
+#include <litmus/details/test_result.hpp>
+
+#ifndef LITMUS_UNTIL_FAIL_RUNS
+#define LITMUS_UNTIL_FAIL_RUNS 100
+#endif
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			'--repeat', '--until-fail' and '--rerun-failed'. Every permutation runs `--repeat` times, '--until-fail'
+			stops at the first failing run (after at most `--repeat` or `LITMUS_UNTIL_FAIL_RUNS` runs), and a failing
+			run is retried up to '--rerun-failed' times. The runs of a permutation are folded into a single result so
+			repeating doesn't multiply the output: the first failing run (or the last one) is reported, with the pass
+			rate and the duration across the runs as its last parameter. A permutation of which some runs passed and
+			others failed, or that passed on a retry, is flaky.
+		*/
+		namespace repeat
+		{
+			// true when permutations may run more than once
+			[[nodiscard]] auto active() noexcept -> bool;
+
+			// the most runs a permutation can have
+			[[nodiscard]] auto runs() noexcept -> size_t;
+
+			// a single run and its retries, `result.retries` holds how many retries it took
+			[[nodiscard]] auto attempt(const std::function<test_result_t()>& run) -> test_result_t;
+
+			// true when another run is due after `runs`
+			[[nodiscard]] auto again(const std::vector<test_result_t>& runs) -> bool;
+
+			struct folded_t
+			{
+				test_result_t result;
+				bool flaky;
+			};
+
+			/*
+				the result that is reported for the runs of permutation `index`. With '--until-fail' the runs after
+				the first failing one are dropped, they only ran when the runs were handed out in parallel.
+			*/
+			[[nodiscard]] auto fold(std::vector<test_result_t> runs, const permutations_t& permutations, size_t index)
+				-> folded_t;
+		} // namespace repeat
+	} // namespace internal
+} // namespace litmus
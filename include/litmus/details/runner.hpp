@@ -1,9 +1,14 @@
 #pragma once
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <span>
+#include <string>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
 
+#include <litmus/details/source_location.hpp>
 #include <litmus/details/utility.hpp>
 
 namespace litmus
@@ -31,6 +36,43 @@ namespace litmus
 		}
 
 		struct test_result_t;
+		class event_loop_t;
+
+		/*
+			all permutations of a single suite registration (for one set of template arguments). The arguments of a
+			permutation are only decoded from its index when it runs, and its parameters are only described when the
+			result is formatted.
+		*/
+		struct permutations_t
+		{
+			virtual ~permutations_t() = default;
+
+			[[nodiscard]] virtual auto size() const noexcept -> size_t = 0;
+			[[nodiscard]] virtual auto run(size_t index) const -> test_result_t = 0;
+			[[nodiscard]] virtual auto describe(size_t index) const -> std::vector<std::string> = 0;
+			[[nodiscard]] virtual auto location() const noexcept -> const source_location& = 0;
+			[[nodiscard]] virtual auto categories() const noexcept -> std::span<const char* const> { return {}; }
+
+			// true when the suite body is a coroutine, which should be started on an event loop
+			[[nodiscard]] virtual auto is_async() const noexcept -> bool { return false; }
+
+			// starts the permutation on `loop`, `result` receives the results once it completes
+			virtual void start(size_t index, event_loop_t& loop, test_result_t& result) const = 0;
+
+			/*
+				called once the permutations of a run completed, with a result per index. Those that did not run
+				(e.g. filtered ones) are empty. Checks over several permutations can add their results here.
+			*/
+			virtual void conclude([[maybe_unused]] std::span<test_result_t> results) const {}
+
+			// true when the suite has a corpus argument, see `generator::corpus`
+			[[nodiscard]] virtual auto fuzzable() const noexcept -> bool { return false; }
+
+			// runs the permutation with `input` decoded as the value of its corpus argument
+			virtual void fuzz([[maybe_unused]] size_t index, [[maybe_unused]] std::span<const std::byte> input,
+							  [[maybe_unused]] test_result_t& result) const
+			{}
+		};
 
 		struct runner_t
 		{
@@ -38,7 +80,7 @@ namespace litmus
 			struct template_pack_t
 			{
 				std::vector<std::string> templates{};
-				std::vector<std::function<test_result_t()>> functions{};
+				std::vector<std::unique_ptr<const permutations_t>> permutations{};
 			};
 
 			using test_t			  = std::unordered_map<uuid_t, template_pack_t>;
@@ -60,7 +102,7 @@ namespace litmus
 			[[nodiscard]] auto size() const noexcept { return m_NamedTests.size(); }
 
 			template <typename... Ts>
-			void test(const char* name, auto&& arg)
+			void test(const char* name, std::unique_ptr<const permutations_t> permutations)
 			{
 				if(auto it = m_NamedTests.find(name); it == std::end(m_NamedTests))
 				{
@@ -73,18 +115,24 @@ namespace litmus
 					if(t.templates.size() != sizeof...(Ts))
 						t.templates = std::vector<std::string>{{type_to_name_internal<Ts>()}...};
 				}
-				t.functions.emplace_back(std::forward<decltype(arg)>(arg));
+				t.permutations.emplace_back(std::move(permutations));
+			}
+
+			// benchmarks are kept apart from the tests, they only run when requested and never concurrently
+			template <typename... Ts>
+			void benchmark(const char* name, std::unique_ptr<const permutations_t> permutations)
+			{
+				m_NamedBenchmarks[name][uuid_for<Ts...>()].permutations.emplace_back(std::move(permutations));
 			}
 
-			template <typename T>
-			void benchmark(T&& arg)
+			[[nodiscard]] auto benchmarks() const noexcept -> const std::unordered_map<const char*, test_t>&
 			{
-				m_Benchmarks.emplace_back(std::forward<T>(arg));
+				return m_NamedBenchmarks;
 			}
 
 		  private:
 			std::unordered_map<const char*, test_t> m_NamedTests;
-			std::vector<std::function<void()>> m_Benchmarks;
+			std::unordered_map<const char*, test_t> m_NamedBenchmarks;
 		};
 
 		extern runner_t runner;
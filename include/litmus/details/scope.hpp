@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <functional>
 #include <stdexcept>
 #include <typeinfo>
@@ -6,6 +7,7 @@
 #include <iostream>
 
 #include <litmus/details/context.hpp>
+#include <litmus/details/explorer.hpp>
 #include <litmus/details/source_location.hpp>
 
 namespace litmus
@@ -24,6 +26,12 @@ namespace litmus
 		template <typename T>
 		concept SupportsTemplates = requires { T::supports_templates == true; };
 
+		template <typename T>
+		concept SupportsExplore = requires { T::supports_explore == true; };
+
+		// defined in <litmus/explore.hpp>
+		struct explore_functor;
+
 		template <typename T>
 		struct is_tpack : std::false_type
 		{};
@@ -75,6 +83,42 @@ namespace litmus
 		template <typename T>
 		concept IsGenerator = requires { T::is_generator; };
 
+		// generators that yield a tuple of values, which are spread over several parameters
+		template <typename T>
+		concept IsSpreadGenerator = IsGenerator<T> && requires { T::is_spread_generator; };
+
+		// generators that are drawn from at run time instead of being expanded into permutations
+		template <typename T>
+		concept IsPropertyGenerator = requires { T::is_property_generator; };
+
+		/*
+			values that stand in for a sequence of values, the suite is invoked for each of them when it runs. Their
+			`for_each` returns why the values could not be read (e.g. a missing file), std::nullopt otherwise.
+		*/
+		template <typename T>
+		concept IsStream = requires { T::is_stream; };
+
+		// streams the fuzzer can substitute its input for, see `generator::corpus`
+		template <typename T>
+		concept IsCorpus = IsStream<T> && requires { T::is_corpus; };
+
+		template <typename T>
+		concept IsGeneratorLike = IsGenerator<T> || IsPropertyGenerator<T> || IsStream<T>;
+
+		// arguments that are resolved to a shared value when the suite runs, see `litmus::fixture`
+		template <typename T>
+		concept IsFixture = requires { T::is_fixture; };
+
+		template <typename T>
+		concept IsFixtureRef = requires { T::is_fixture_ref; };
+
+		template <typename T>
+		concept HasDescribe = requires(const std::remove_cvref_t<T>& t) {
+								  {
+									  t.describe()
+									  } -> std::convertible_to<std::string>;
+							  };
+
 		template <typename T>
 		concept HasToString = requires(std::remove_cvref_t<T> t) { std::to_string(t); };
 
@@ -84,6 +128,13 @@ namespace litmus
 			return std::to_string(val);
 		}
 
+		template <HasDescribe T>
+			requires(!HasToString<T>)
+		auto stringify(T&& val) -> std::string
+		{
+			return val.describe();
+		}
+
 		template <typename T>
 		auto stringify(T&&) -> std::string
 		{
@@ -111,10 +162,57 @@ namespace litmus
 			else
 			{
 				return 1u;
-				/* code */
 			}
 		}
 
+		// generators that can produce the value at any index, which permutations are decoded with
+		template <typename T>
+		concept IsRandomAccessGenerator = IsGenerator<T> && requires(const T& generator, size_t index) {
+																generator.at(index);
+															};
+
+		template <typename T>
+		[[nodiscard]] constexpr auto generator_at(const T& generator, size_t index)
+		{
+			static_assert(IsRandomAccessGenerator<T>,
+						  "generators need to provide `at(index)`, the value of the permutation at that index");
+			return generator.at(index);
+		}
+
+		template <typename T>
+		[[nodiscard]] constexpr auto permutation_value(const T& value, size_t index)
+		{
+			if constexpr(IsSpreadGenerator<T>)
+				return generator_at(value, index);
+			else if constexpr(IsGenerator<T>)
+				return std::tuple<decltype(generator_at(value, index))>{generator_at(value, index)};
+			else
+				return std::tuple<T>{value};
+		}
+
+		// amount of permutations the generators in the argument pack expand to
+		template <typename... Ts>
+		[[nodiscard]] constexpr auto permutation_count(const std::tuple<Ts...>& args) noexcept -> size_t
+		{
+			return std::apply([](const auto&... values) { return (size_t{1} * ... * generator_size(values)); }, args);
+		}
+
+		/*
+			decodes the arguments of the permutation at `index`, generators are replaced by their value (spread
+			generators by their values), the last argument varies the fastest.
+		*/
+		template <typename... Ts>
+		[[nodiscard]] constexpr auto permutation_at(const std::tuple<Ts...>& args, size_t index)
+		{
+			return [&]<size_t... N>(std::index_sequence<N...>) {
+				[[maybe_unused]] std::array<size_t, sizeof...(Ts)> indices{};
+				((indices[sizeof...(Ts) - 1 - N] = index % generator_size(std::get<sizeof...(Ts) - 1 - N>(args)),
+				  index /= generator_size(std::get<sizeof...(Ts) - 1 - N>(args))),
+				 ...);
+				return std::tuple_cat(permutation_value(std::get<N>(args), indices[N])...);
+			}(std::index_sequence_for<Ts...>{});
+		}
+
 		template <typename tuple_t>
 		class scope_args_container
 		{
@@ -124,49 +222,41 @@ namespace litmus
 			template <typename... Ys>
 			constexpr scope_args_container(Ys&&... args) : m_ScopeArgs(std::forward<Ys>(args)...)
 			{}
+		};
 
-			constexpr void unpack_args(auto&& fn) const { unpack_args_impl0<0>(fn); }
+		/*
+			compile time filter over the template combinations of a suite, a combination is only instantiated and
+			registered when every predicate accepts it. Predicates are captureless lambdas that take the combination
+			as template arguments (NTTP values are passed as `vpack_value<V>`) and return a bool.
+		*/
+		template <typename... Predicates>
+		struct template_filter_t
+		{
+			template <typename Predicate>
+			using append = template_filter_t<Predicates..., Predicate>;
 
-		  private:
-			template <size_t Index, typename... Ts>
-			constexpr void unpack_args_impl1(auto& fn, Ts&&... values) const
+			template <typename... Ts>
+			static constexpr bool accepts() noexcept
 			{
-				using fn_type = std::tuple_element_t<Index, tuple_t>;
-				if constexpr(IsGenerator<fn_type>)
-				{
-					auto generator{std::get<Index>(m_ScopeArgs)};
-
-					for(auto i = 0u; i < generator.size(); ++i)
-					{
-						unpack_args_impl0<Index + 1>(fn, std::forward<Ts>(values)..., generator.next());
-					}
-				}
-				else
-				{
-					unpack_args_impl0<Index + 1>(fn, std::forward<Ts>(values)..., std::get<Index>(m_ScopeArgs));
-				}
-			}
-
-			// unpack the argument pack, detect generators
-			template <size_t Index, typename... Ts>
-			constexpr void unpack_args_impl0(auto& fn, Ts&&... values) const
-			{
-				if constexpr(std::tuple_size_v<tuple_t> == Index)
-				{
-					fn(std::forward<Ts>(values)...);
-				}
-				else
-				{
-					unpack_args_impl1<Index>(fn, std::forward<Ts>(values)...);
-				}
+				return (static_cast<bool>(Predicates{}.template operator()<Ts...>()) && ...);
 			}
 		};
 
-		template <typename Functor, typename tuple_t, typename... FnTypes>
+		template <typename Functor, typename tuple_t, typename Filter, typename... FnTypes>
 		class templated_scope_t : public scope_args_container<tuple_t>
 		{
 			using args_base = scope_args_container<tuple_t>;
 
+			template <typename... InvokeTypes>
+			constexpr void register_combination(auto& fn)
+			{
+				if constexpr(Filter::template accepts<InvokeTypes...>())
+				{
+					m_ScopeObject.template operator()<InvokeTypes...>(fn, m_Name, m_Location, m_Categories,
+																	  args_base::m_ScopeArgs);
+				}
+			}
+
 			template <size_t Index, typename... InvokeTypes, size_t... N>
 			constexpr void unpack_templates_impl1(auto& fn, std::index_sequence<N...>)
 			{
@@ -174,12 +264,7 @@ namespace litmus
 
 				if constexpr(Index + 1 == sizeof...(FnTypes))
 				{
-					(args_base::unpack_args([&fn, name = m_Name, location = m_Location, &scope = m_ScopeObject,
-											 &categories = m_Categories](auto&&... values) {
-						 scope.template operator()<InvokeTypes..., typename fn_type::template type<N>>(
-							 fn, name, location, categories, std::forward<decltype(values)>(values)...);
-					 }),
-					 ...);
+					(register_combination<InvokeTypes..., typename fn_type::template type<N>>(fn), ...);
 				}
 				else
 				{
@@ -210,6 +295,15 @@ namespace litmus
 				return *this;
 			}
 
+			// only instantiates (and registers) the template combinations for which `Predicate` returns true
+			template <auto Predicate>
+			auto where() -> templated_scope_t<Functor, tuple_t, typename Filter::template append<decltype(Predicate)>,
+											  FnTypes...>
+			{
+				return {std::move(m_ScopeObject), m_Name, std::move(m_Categories), std::move(args_base::m_ScopeArgs),
+						m_Location};
+			}
+
 			constexpr operator bool() const noexcept { return m_HasRun; }
 
 		  private:
@@ -233,6 +327,11 @@ namespace litmus
 					Ys&&... values)
 				: args_base(std::forward<Ys>(values)...), m_Name(name), m_Categories(categories), m_Location(location)
 			{}
+			scope_t(Functor&& scope, const char* name, std::vector<const char*>&& categories,
+					const source_location& location, tuple_t&& values)
+				: args_base(std::move(values)), m_Name(name), m_Categories(std::move(categories)), m_Location(location),
+				  m_ScopeObject(std::move(scope))
+			{}
 			const char* name() noexcept { return m_Name; }
 
 			template <typename Fn>
@@ -249,18 +348,15 @@ namespace litmus
 				{
 					if constexpr(SupportsGenerators<Functor>)
 					{
-						args_base::unpack_args([&fn, name = m_Name, location = m_Location, &scope = m_ScopeObject,
-												&categories = m_Categories](auto&&... values) {
-							scope.template operator()<>(fn, name, location, categories,
-														std::forward<decltype(values)>(values)...);
-						});
+						m_ScopeObject.template operator()<>(fn, m_Name, m_Location, m_Categories,
+															args_base::m_ScopeArgs);
 					}
 					else
 					{
 						std::apply(
 							[&fn, name = m_Name, location = m_Location, &scope = m_ScopeObject,
 							 &categories = m_Categories](auto&&... values) {
-								static_assert((!IsGenerator<std::remove_cvref_t<decltype(values)>> && ...),
+								static_assert((!IsGeneratorLike<std::remove_cvref_t<decltype(values)>> && ...),
 											  "generator types not supported on sections.");
 								scope.template operator()<>(fn, name, location, categories,
 															std::forward<decltype(values)>(values)...);
@@ -285,11 +381,21 @@ namespace litmus
 
 			template <IsTemplatePack Y, IsTemplatePack... Ys>
 				requires(SupportsTemplates<Functor>)
-			auto templates() -> templated_scope_t<Functor, tuple_t, Y, Ys...>
+			auto templates() -> templated_scope_t<Functor, tuple_t, template_filter_t<>, Y, Ys...>
+			{
+				return templated_scope_t<Functor, tuple_t, template_filter_t<>, Y, Ys...>{
+					std::move(m_ScopeObject), m_Name, std::move(m_Categories), std::move(args_base::m_ScopeArgs),
+					m_Location};
+			}
+
+			// runs the suite under the concurrency explorer, every schedule is a different thread interleaving
+			template <typename Explorer = explore_functor>
+				requires(SupportsExplore<Functor>)
+			auto explore(size_t schedules = 100, explore_strategy_t strategy = explore_strategy_t::random)
+				-> scope_t<Explorer, Ts...>
 			{
-				return templated_scope_t<Functor, tuple_t, Y, Ys...>{std::move(m_ScopeObject), m_Name,
-																	 std::move(m_Categories),
-																	 std::move(args_base::m_ScopeArgs), m_Location};
+				return {Explorer{schedules, strategy}, m_Name, std::move(m_Categories), m_Location,
+						std::move(args_base::m_ScopeArgs)};
 			}
 
 			constexpr operator bool() const noexcept { return m_HasRun; }
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			minimal binary encoding used to move results between processes of the same binary. Values are written in
+			native byte order and layout, so the encoding is not meant to be stored or sent to another machine.
+		*/
+		class binary_writer_t
+		{
+		  public:
+			binary_writer_t(std::string& buffer) noexcept : m_Buffer(buffer) {}
+
+			template <typename T>
+				requires(std::is_trivially_copyable_v<T>)
+			void write(const T& value)
+			{
+				m_Buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+			}
+
+			void write(std::string_view value)
+			{
+				write(static_cast<std::uint64_t>(value.size()));
+				m_Buffer.append(value);
+			}
+
+		  private:
+			std::string& m_Buffer;
+		};
+
+		class binary_reader_t
+		{
+		  public:
+			binary_reader_t(std::string_view buffer) noexcept : m_Buffer(buffer) {}
+
+			// returns false when the buffer does not hold enough data, `value` is left untouched in that case.
+			template <typename T>
+				requires(std::is_trivially_copyable_v<T>)
+			[[nodiscard]] auto read(T& value) noexcept -> bool
+			{
+				if(m_Buffer.size() < sizeof(T)) return false;
+				std::memcpy(&value, m_Buffer.data(), sizeof(T));
+				m_Buffer.remove_prefix(sizeof(T));
+				return true;
+			}
+
+			[[nodiscard]] auto read(std::string& value) -> bool
+			{
+				std::uint64_t size{0};
+				if(!read(size) || m_Buffer.size() < size) return false;
+				value.assign(m_Buffer.data(), static_cast<size_t>(size));
+				m_Buffer.remove_prefix(static_cast<size_t>(size));
+				return true;
+			}
+
+			[[nodiscard]] auto remaining() const noexcept -> std::string_view { return m_Buffer; }
+
+		  private:
+			std::string_view m_Buffer;
+		};
+	} // namespace internal
+} // namespace litmus
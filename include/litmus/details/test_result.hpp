@@ -2,16 +2,29 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <cstdint>
 #include <cstring>
 #include <numeric>
+#include <optional>
 #include <span>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 #include <unordered_map>
 
+#include <litmus/details/exceptions.hpp>
+#include <litmus/details/histogram.hpp>
+#include <litmus/details/mpsc_queue.hpp>
+#include <litmus/details/serialize.hpp>
 #include <litmus/details/source_location.hpp>
+#include <litmus/details/timing.hpp>
+#include <litmus/details/utility.hpp>
 #include <litmus/details/verbosity.hpp>
 #include <litmus/litmus.hpp>
 
@@ -89,13 +102,19 @@ namespace litmus
 				std::string name{};
 				std::vector<std::string> parameters{};
 				test_id_t id{};
-				const source_location& location;
+				source_location location{};
 				size_t pass{0};
 				size_t fail{0};
 				size_t fatal{0};
 				size_t children{0};
-				std::chrono::time_point<std::chrono::high_resolution_clock> duration_start{};
-				std::chrono::time_point<std::chrono::high_resolution_clock> duration_end{};
+				// ticks of the '--timing' clock
+				std::uint64_t start{0};
+				std::uint64_t end{0};
+
+				[[nodiscard]] auto duration() const noexcept -> std::chrono::nanoseconds
+				{
+					return timing::to_duration(start, end);
+				}
 			};
 
 			struct scope_close_t
@@ -128,14 +147,67 @@ namespace litmus
 				} result{};
 
 				size_t parent_index{};
+				// results of the same call site that were folded into this record, see `aggregate`
+				size_t repeats{0};
+
+				[[nodiscard]] auto repeats_text() const -> std::string
+				{
+					if(repeats == 0) return {};
+					return " (" + std::to_string(repeats) +
+						   ((result == result_t::pass) ? " more passes)" : " more failures suppressed)");
+				}
+			};
+
+			// the latencies a benchmark permutation measured in nanoseconds, see `benchmark_permutations_t`
+			struct measurement_t
+			{
+				std::uint64_t operations{0};
+				double mean{0.0};
+				double p50{0.0};
+				double p90{0.0};
+				double p99{0.0};
+				double p999{0.0};
+				double max{0.0};
+				// operations started per second (0 when back to back), and the samples once corrected for it
+				double rate{0.0};
+				std::uint64_t samples{0};
+				// quartile coefficient of dispersion of the kept sample, which took `attempts` measurements
+				double dispersion{0.0};
+				std::uint64_t attempts{0};
+				bool noisy{false};
+				// the complexity class a sweep over input sizes fits, on the last permutation of the sweep
+				std::string complexity{};
+				double rms{0.0};
+
+				[[nodiscard]] auto to_string() const -> std::string
+				{
+					auto res = combine_text(std::to_string(operations), " ops, mean ", nanoseconds_to_string(mean),
+											", p50 ", nanoseconds_to_string(p50), ", p90 ", nanoseconds_to_string(p90),
+											", p99 ", nanoseconds_to_string(p99), ", p99.9 ",
+											nanoseconds_to_string(p999), ", max ", nanoseconds_to_string(max));
+					if(rate > 0.0)
+						res += combine_text(", ", std::to_string(static_cast<std::uint64_t>(rate)), "/s (",
+											std::to_string(samples), " samples when corrected)");
+					if(noisy)
+						res += combine_text(", noisy (dispersion ", std::to_string(std::lround(dispersion * 100.0)),
+											"% after ", std::to_string(attempts), " attempts)");
+					else if(attempts > 1)
+						res += combine_text(", stable after ", std::to_string(attempts), " attempts");
+					if(!complexity.empty())
+						res += combine_text(", fits ", complexity, ", rms ", std::to_string(std::lround(rms * 100.0)),
+											"%");
+					return res;
+				}
 			};
 
 			void scope_open(const std::string& name, test_id_t id, const source_location& location,
 							std::vector<std::string> parameters = {})
 			{
+				// nested scopes are only timed when asked for, the suite totals are always kept
+				const auto timed = timing::state.scopes || active_scope_index.empty();
 				active_scope_index.push(results.size());
 				results.emplace_back(
-					scope_t{name, parameters, id, location, {}, {}, {}, {}, std::chrono::high_resolution_clock::now()});
+					scope_t{name, parameters, id, location, {}, {}, {}, {}, timed ? timing::now() : 0u});
 			} // namespace internal
 
 			void scope_results(size_t index, size_t pass, size_t fail, size_t fatal)
@@ -155,11 +227,12 @@ namespace litmus
 			void scope_close()
 			{
 				const auto index = active_scope_index.top();
+				merge_remote(index);
 				results.emplace_back(scope_close_t{index});
 				if(auto* scope = std::get_if<scope_t>(&results[index]); scope)
 				{
-					scope->children		= results.size() - index - 1;
-					scope->duration_end = std::chrono::high_resolution_clock::now();
+					scope->children = results.size() - index - 1;
+					if(timing::state.scopes || active_scope_index.size() == 1) scope->end = timing::now();
 				}
 				else
 				{
@@ -178,26 +251,59 @@ namespace litmus
 							 ((pass) ? expect_t::result_t::pass
 									 : ((fatal) ? expect_t::result_t::fatal : expect_t::result_t::fail)),
 							 parent});
+				count_result(parent, pass, fatal);
+			}
 
-				if(auto* scope = std::get_if<scope_t>(&results[parent]); scope)
+			// records an expect in the root scope of a result that completed, see `permutations_t::conclude`
+			void append_result(const std::string& lhs_value, const std::string& rhs_value, const std::string& lhs_user,
+							   const std::string& rhs_user, expect_t::operation_t operation, bool pass, bool fatal,
+							   const std::string& info)
+			{
+				auto close = std::move(results.back());
+				results.pop_back();
+				active_scope_index.push(0);
+				expect_result(lhs_value, rhs_value, lhs_user, rhs_user, operation, pass, fatal, info);
+				active_scope_index.pop();
+				results.emplace_back(std::move(close));
+				std::get<scope_t>(results[0]).children = results.size() - 1;
+			}
+
+			// counts a passing expect in the active scope without recording it, see `config_t::data_t::fuzzing`
+			void count_pass() { count_result(active_scope_index.top(), true, false); }
+
+			// queue other threads record their expects in, their `parent_index` is the scope they are attributed to
+			[[nodiscard]] auto remote_queue() -> const std::shared_ptr<mpsc_queue_t<expect_t>>&
+			{
+				if(!remote) remote = std::make_shared<mpsc_queue_t<expect_t>>();
+				return remote;
+			}
+
+			/*
+				per call site aggregation ('--aggregate'). Returns true when the result was folded into an earlier
+				record of the same call site in the active scope, only the scope totals are updated in that case.
+				The first pass and the first `kept_failures` failures are not folded, the caller should record those
+				through `expect_result`.
+			*/
+			[[nodiscard]] auto aggregate(const source_location& location, bool pass, bool fatal, size_t kept_failures)
+				-> bool
+			{
+				const auto parent = active_scope_index.top();
+				auto& site		  = call_sites[{parent, location.file_name(), location.line(), location.column()}];
+				if(pass && !site.pass)
 				{
-					if(pass)
-						scope->pass += 1;
-					else if(fatal)
-					{
-						fatal = true;
-						scope->fatal += 1;
-					}
-					else
-					{
-						fails = true;
-						scope->fail += 1;
-					}
+					site.pass = results.size();
+					return false;
 				}
-				else
+				if(!pass && site.failures < kept_failures)
 				{
-					throw std::exception();
+					site.failures += 1;
+					site.fail = results.size();
+					return false;
 				}
+
+				std::get<expect_t>(results[*((pass) ? site.pass : site.fail)]).repeats += 1;
+				count_result(parent, pass, fatal);
+				return true;
 			}
 
 			void calc_total(scope_t& parent, std::span<std::variant<scope_t, scope_close_t, expect_t>> children)
@@ -239,6 +345,7 @@ namespace litmus
 				if(suite_scope)
 				{
 					if(!suite_scope->parameters.empty()) logger->suite_iterate_parameters(suite_scope->parameters);
+					if(measurement) logger->suite_iterate_measurement(*measurement);
 				}
 				else
 					throw std::exception();
@@ -271,14 +378,195 @@ namespace litmus
 					pass	 = scope->pass;
 					fail	 = scope->fail;
 					fatal	 = scope->fatal;
-					duration = std::chrono::duration_cast<std::chrono::microseconds>(scope->duration_end -
-																					 scope->duration_start);
+					duration = std::chrono::duration_cast<std::chrono::microseconds>(scope->duration());
 				}
 				else
 					throw std::exception();
 			}
 
-			void clear() { results.clear(); }
+			void clear()
+			{
+				results.clear();
+				call_sites.clear();
+				measurement.reset();
+			}
+
+			// appends the results as a single record to `buffer`, see `deserialize`
+			void serialize(std::string& buffer) const
+			{
+				std::string payload{};
+				binary_writer_t writer{payload};
+				writer.write(fails);
+				writer.write(fatal);
+				writer.write(static_cast<std::uint64_t>(retries));
+				writer.write(measurement.has_value());
+				if(measurement)
+				{
+					writer.write(measurement->operations);
+					for(auto value : {measurement->mean, measurement->p50, measurement->p90, measurement->p99,
+									  measurement->p999, measurement->max, measurement->rate})
+						writer.write(value);
+					writer.write(measurement->samples);
+					writer.write(measurement->dispersion);
+					writer.write(measurement->attempts);
+					writer.write(measurement->noisy);
+					writer.write(measurement->complexity);
+					writer.write(measurement->rms);
+				}
+				writer.write(static_cast<std::uint64_t>(results.size()));
+				for(const auto& result : results)
+				{
+					writer.write(static_cast<std::uint8_t>(result.index()));
+					if(const auto* scope = std::get_if<scope_t>(&result); scope)
+					{
+						writer.write(scope->name);
+						writer.write(static_cast<std::uint64_t>(scope->parameters.size()));
+						for(const auto& parameter : scope->parameters) writer.write(parameter);
+						writer.write(static_cast<std::uint64_t>(scope->id.size()));
+						for(size_t i = 0; i < scope->id.size(); ++i) writer.write(scope->id.get(i));
+						// only valid within the same binary, which is all forked processes need
+						writer.write(scope->location);
+						writer.write(static_cast<std::uint64_t>(scope->pass));
+						writer.write(static_cast<std::uint64_t>(scope->fail));
+						writer.write(static_cast<std::uint64_t>(scope->fatal));
+						writer.write(static_cast<std::uint64_t>(scope->children));
+						writer.write(scope->start);
+						writer.write(scope->end);
+					}
+					else if(const auto* scope_close = std::get_if<scope_close_t>(&result); scope_close)
+					{
+						writer.write(static_cast<std::uint64_t>(scope_close->scope_index));
+					}
+					else if(const auto* expect = std::get_if<expect_t>(&result); expect)
+					{
+						writer.write(expect->lhs_value);
+						writer.write(expect->rhs_value);
+						writer.write(expect->lhs_user);
+						writer.write(expect->rhs_user);
+						writer.write(expect->operation);
+						writer.write(expect->info);
+						writer.write(expect->result);
+						writer.write(static_cast<std::uint64_t>(expect->parent_index));
+						writer.write(static_cast<std::uint64_t>(expect->repeats));
+					}
+				}
+				binary_writer_t{buffer}.write(std::string_view{payload});
+			}
+
+			// reads a single record written by `serialize`, returns false when the buffer holds no complete record.
+			[[nodiscard]] auto deserialize(binary_reader_t& reader) -> bool
+			{
+				std::string payload{};
+				if(!reader.read(payload)) return false;
+				binary_reader_t record{payload};
+
+				auto read_size = [&record]() -> size_t {
+					std::uint64_t value{0};
+					if(!record.read(value)) except(std::runtime_error("truncated result record"));
+					return static_cast<size_t>(value);
+				};
+				auto read = [&record](auto& value) {
+					if(!record.read(value)) except(std::runtime_error("truncated result record"));
+				};
+
+				results.clear();
+				read(fails);
+				read(fatal);
+				retries = read_size();
+				bool measured{false};
+				read(measured);
+				measurement.reset();
+				if(measured)
+				{
+					auto& value = measurement.emplace();
+					read(value.operations);
+					for(auto* field : {&value.mean, &value.p50, &value.p90, &value.p99, &value.p999, &value.max,
+									   &value.rate})
+						read(*field);
+					read(value.samples);
+					read(value.dispersion);
+					read(value.attempts);
+					read(value.noisy);
+					read(value.complexity);
+					read(value.rms);
+				}
+				const auto count = read_size();
+				results.reserve(count);
+				for(size_t i = 0; i < count; ++i)
+				{
+					std::uint8_t kind{0};
+					read(kind);
+					if(kind == 0)
+					{
+						scope_t scope{};
+						read(scope.name);
+						scope.parameters.resize(read_size());
+						for(auto& parameter : scope.parameters) read(parameter);
+						const auto depth = read_size();
+						for(size_t d = 0; d < depth; ++d)
+						{
+							LITMUS_MAX_TEST_ID_TYPE value{};
+							read(value);
+							scope.id.set(d, value);
+						}
+						read(scope.location);
+						scope.pass	   = read_size();
+						scope.fail	   = read_size();
+						scope.fatal	   = read_size();
+						scope.children = read_size();
+						read(scope.start);
+						read(scope.end);
+						results.emplace_back(std::move(scope));
+					}
+					else if(kind == 1)
+					{
+						results.emplace_back(scope_close_t{read_size()});
+					}
+					else
+					{
+						expect_t expect{};
+						read(expect.lhs_value);
+						read(expect.rhs_value);
+						read(expect.lhs_user);
+						read(expect.rhs_user);
+						read(expect.operation);
+						read(expect.info);
+						read(expect.result);
+						expect.parent_index = read_size();
+						expect.repeats		= read_size();
+						results.emplace_back(std::move(expect));
+					}
+				}
+				return true;
+			}
+
+			/*
+				appends the records of a path that was executed in a forked process. `path` started out as a copy of
+				these results (with only the root scope open), its root scope is merged into ours.
+			*/
+			void append_path(const test_result_t& path)
+			{
+				if(path.results.empty()) return;
+				const auto offset = results.size() - 1;
+				auto remap		  = [offset](size_t index) { return (index == 0) ? index : index + offset; };
+
+				auto& root				= std::get<scope_t>(results[0]);
+				const auto& path_root = std::get<scope_t>(path.results[0]);
+				root.pass += path_root.pass;
+				root.fail += path_root.fail;
+				root.fatal += path_root.fatal;
+
+				for(auto it = std::next(std::begin(path.results)); it != std::end(path.results); ++it)
+				{
+					auto& result = results.emplace_back(*it);
+					if(auto* scope_close = std::get_if<scope_close_t>(&result); scope_close)
+						scope_close->scope_index = remap(scope_close->scope_index);
+					else if(auto* expect = std::get_if<expect_t>(&result); expect)
+						expect->parent_index = remap(expect->parent_index);
+				}
+				fails = fails || path.fails;
+				fatal = fatal || path.fatal;
+			}
 
 			auto& root() const
 			{
@@ -292,9 +580,74 @@ namespace litmus
 
 			bool fails{false};
 			bool fatal{false};
+			// '--rerun-failed', the times the permutation failed and ran again before this result
+			size_t retries{0};
+			// set on the results of benchmark permutations
+			std::optional<measurement_t> measurement{};
 			std::vector<std::variant<scope_t, scope_close_t, expect_t>> results{};
 			std::vector<test_id_t> failed_ids{};
 			std::stack<size_t> active_scope_index{};
+
+		  private:
+			/*
+				appends the expects other threads recorded for the closing scope, or for any scope opened after it.
+				Those recorded for its parents are kept until the parent closes, so they end up in its range.
+			*/
+			void merge_remote(size_t closing)
+			{
+				if(!remote) return;
+				auto records = std::move(remote_pending);
+				remote_pending = {};
+				for(auto& record : remote->take()) records.emplace_back(std::move(record));
+
+				for(auto& record : records)
+				{
+					if(record.parent_index < closing)
+					{
+						remote_pending.emplace_back(std::move(record));
+						continue;
+					}
+					const auto parent = record.parent_index;
+					const auto result = record.result;
+					results.emplace_back(std::move(record));
+					count_result(parent, result == expect_t::result_t::pass, result == expect_t::result_t::fatal);
+					if(result == expect_t::result_t::fatal) fatal = true;
+				}
+			}
+
+			void count_result(size_t parent, bool pass, bool is_fatal)
+			{
+				if(auto* scope = std::get_if<scope_t>(&results[parent]); scope)
+				{
+					if(pass)
+						scope->pass += 1;
+					else if(is_fatal)
+						scope->fatal += 1;
+					else
+					{
+						fails = true;
+						scope->fail += 1;
+					}
+				}
+				else
+				{
+					throw std::exception();
+				}
+			}
+
+			struct call_site_t
+			{
+				std::optional<size_t> pass{};
+				std::optional<size_t> fail{};
+				size_t failures{0};
+			};
+
+			std::shared_ptr<mpsc_queue_t<expect_t>> remote{};
+			std::vector<expect_t> remote_pending{};
+
+			// keyed on the active scope index and the source location of the expect
+			std::map<std::tuple<size_t, const char*, std::uint_least32_t, std::uint_least32_t>, call_site_t>
+				call_sites{};
 		}; // namespace litmus
 
 		class benchmark_result_t
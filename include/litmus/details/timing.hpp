@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LITMUS_TSC_SUPPORTED
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#if defined(__linux__)
+#define LITMUS_MONOTONIC_RAW_SUPPORTED
+#endif
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		enum class clock_source_t : std::uint8_t
+		{
+			steady,
+			tsc,		   // time stamp counter, calibrated against the steady clock
+			monotonic_raw, // CLOCK_MONOTONIC_RAW, not slewed by NTP
+			none,		   // scopes are not timed
+		};
+
+		/*
+			clock the scopes are timed with ('--timing'). Scopes only store the ticks of the selected clock, they are
+			converted to durations when the results are reported.
+		*/
+		namespace timing
+		{
+			struct state_t
+			{
+				clock_source_t source{clock_source_t::steady};
+				// time the nested scopes as well, the suites themselves are always timed
+				bool scopes{true};
+				double nanoseconds_per_tick{1e9 * std::chrono::steady_clock::period::num /
+											std::chrono::steady_clock::period::den};
+			};
+
+			extern state_t state;
+
+			// switches to `source`, returns false (and keeps the current clock) when it's not available
+			auto select(clock_source_t source) -> bool;
+
+			[[nodiscard]] inline auto now() noexcept -> std::uint64_t
+			{
+				// `select` never picks a source the platform lacks, the next one down only stands in to compile
+				switch(state.source)
+				{
+				case clock_source_t::tsc:
+#ifdef LITMUS_TSC_SUPPORTED
+				{
+					unsigned int aux{};
+					return static_cast<std::uint64_t>(__rdtscp(&aux));
+				}
+#else
+					[[fallthrough]];
+#endif
+				case clock_source_t::monotonic_raw:
+#ifdef LITMUS_MONOTONIC_RAW_SUPPORTED
+				{
+					timespec time{};
+					clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+					return static_cast<std::uint64_t>(time.tv_sec) * 1'000'000'000u +
+						   static_cast<std::uint64_t>(time.tv_nsec);
+				}
+#else
+					[[fallthrough]];
+#endif
+				case clock_source_t::steady:
+					return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+				case clock_source_t::none:
+					break;
+				}
+				return 0u;
+			}
+
+			[[nodiscard]] inline auto to_duration(std::uint64_t start, std::uint64_t end) noexcept
+				-> std::chrono::nanoseconds
+			{
+				if(end <= start) return std::chrono::nanoseconds{0};
+				return std::chrono::nanoseconds{
+					static_cast<std::int64_t>(static_cast<double>(end - start) * state.nanoseconds_per_tick)};
+			}
+		} // namespace timing
+	} // namespace internal
+} // namespace litmus
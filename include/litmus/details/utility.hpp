@@ -3,6 +3,7 @@
 #include <string>
 #include <type_traits>
 #include <numeric>
+#include <vector>
 
 #include "strtype/strtype.hpp"
 
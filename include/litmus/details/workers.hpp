@@ -0,0 +1,47 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <litmus/details/test_result.hpp>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			'--workers' execution strategy. The runner forks worker processes that are connected to it over a unix
+			domain socket, and hands out work one item at a time to whichever worker is idle, so slow items don't hold
+			back the ones queued behind them. Workers send their results back as serialized records. A worker that
+			terminates abnormally, or runs an item for longer than the timeout ('--worker-timeout'), is replaced and
+			the remaining work is handed out to the others.
+		*/
+		namespace workers
+		{
+			struct outcome_t
+			{
+				std::optional<test_result_t> result{};
+				// the worker that ran the item and how it terminated, when the item has no result
+				int pid{0};
+				std::string termination{};
+			};
+
+			// true when the strategy is available on this platform
+			[[nodiscard]] auto supported() noexcept -> bool;
+
+			/*
+				runs `run(item)` for every item in [0, count) on `workers` processes, and returns the outcomes in item
+				order. Items that were running in a worker that terminated abnormally, or that were killed after
+				running for longer than `timeout`, have no result. `finished` is invoked in this process as the items
+				come in, in the order they finish.
+			*/
+			[[nodiscard]] auto
+				run(size_t workers, size_t count, const std::function<test_result_t(size_t)>& run,
+					const std::function<void(size_t, const std::optional<test_result_t>&)>& finished = {},
+					std::optional<std::chrono::milliseconds> timeout = {}) -> std::vector<outcome_t>;
+		} // namespace workers
+	} // namespace internal
+} // namespace litmus
@@ -196,15 +196,55 @@ namespace litmus
 			std::string message;
 		} expect_info;
 
+		// true when '--aggregate' folded the result into an earlier record, its strings are never built in that case
+		template <bool Fatal>
+		[[nodiscard]] inline auto aggregated(bool res, const source_location& location) -> bool
+		{
+			if(config->aggregate == 0 || remote_target.queue ||
+			   !suite_context.output.aggregate(location, res, Fatal, config->aggregate))
+				return false;
+			expect_info.message = {};
+
+			suite_context.output.fatal = !res && Fatal;
+			return true;
+		}
+
+		// records the result in the suite of this thread, or in the suite the thread is attached to
+		inline void record_expect(const std::string& lhs_value, const std::string& rhs_value,
+								  const std::string& lhs_user, const std::string& rhs_user,
+								  test_result_t::expect_t::operation_t operation, bool pass, bool fatal,
+								  const std::string& info)
+		{
+			if(remote_target.queue)
+			{
+				using result_t = test_result_t::expect_t::result_t;
+				remote_target.queue->push(test_result_t::expect_t{
+					lhs_value, rhs_value, lhs_user, rhs_user, operation, info,
+					(pass) ? result_t::pass : ((fatal) ? result_t::fatal : result_t::fail), remote_target.scope});
+				return;
+			}
+			suite_context.output.expect_result(lhs_value, rhs_value, lhs_user, rhs_user, operation, pass, fatal, info);
+		}
+
+		// true when a passing expect was only counted, the fuzzer only needs to know what failed
+		[[nodiscard]] inline auto tallied(bool res) -> bool
+		{
+			if(!res || !config->fuzzing || remote_target.queue) return false;
+			suite_context.output.count_pass();
+			expect_info.message = {};
+			return true;
+		}
+
 		template <bool Fatal>
 		inline void log_expect(const auto& lhs, const auto& rhs, bool res,
 							   test_result_t::expect_t::operation_t operation, const source_location& location) noexcept
 		{
+			if(tallied(res) || aggregated<Fatal>(res, location)) return;
 			std::string lhs_user{};
 			std::string rhs_user{};
 			evaluate(location, operation, (Fatal) ? "require" : "expect", lhs_user, rhs_user);
-			suite_context.output.expect_result(to_string_fn(lhs), to_string_fn(rhs), lhs_user, rhs_user, operation, res,
-											   Fatal, expect_info.message);
+			record_expect(to_string_fn(lhs), to_string_fn(rhs), lhs_user, rhs_user, operation, res, Fatal,
+						  expect_info.message);
 			expect_info.message = {};
 
 			suite_context.output.fatal = !res && Fatal;
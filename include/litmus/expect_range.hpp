@@ -0,0 +1,327 @@
+#pragma once
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <litmus/approx.hpp>
+#include <litmus/expect.hpp>
+
+#ifndef LITMUS_RANGE_MISMATCHES
+#define LITMUS_RANGE_MISMATCHES 8
+#endif
+
+namespace litmus
+{
+	template <typename Predicate>
+	struct satisfies_t
+	{
+		Predicate predicate;
+	};
+
+	// predicate form of `expect_range`, `== satisfies(fn)` expects every element to satisfy `fn`, `!=` none of them.
+	template <typename Predicate>
+	[[nodiscard]] auto satisfies(Predicate&& predicate) -> satisfies_t<std::decay_t<Predicate>>
+	{
+		return {std::forward<Predicate>(predicate)};
+	}
+
+	template <typename Predicate>
+	struct value_to_string_t<satisfies_t<Predicate>>
+	{
+		std::string operator()([[maybe_unused]] const satisfies_t<Predicate>& value) const noexcept
+		{
+			return "predicate";
+		}
+	};
+
+	inline namespace internal
+	{
+		template <typename T>
+		concept IsCheckedRange = std::ranges::random_access_range<T> && std::ranges::sized_range<T>;
+
+		// element `index` of the right hand side, ranges are compared element wise and other values are broadcast
+		template <typename T>
+		[[nodiscard]] constexpr auto range_rhs_at(const T& rhs, size_t index) noexcept -> decltype(auto)
+		{
+			if constexpr(IsCheckedRange<T>)
+				return std::ranges::begin(rhs)[index];
+			else
+				return (rhs);
+		}
+
+		/*
+			counts the elements for which `compare` fails. Contiguous ranges are compared through raw pointers
+			without early exits so the compiler can vectorize the loop, integral equality compares the memory
+			directly.
+		*/
+		template <typename Lhs, typename Rhs, typename Compare>
+		[[nodiscard]] auto count_range_failures(const Lhs& lhs, const Rhs& rhs, Compare compare, size_t size) noexcept
+			-> size_t
+		{
+			if constexpr(std::ranges::contiguous_range<Lhs>)
+			{
+				const auto* data = std::ranges::data(lhs);
+				if constexpr(std::ranges::contiguous_range<Rhs>)
+				{
+					using lhs_t = std::ranges::range_value_t<Lhs>;
+					using rhs_t = std::ranges::range_value_t<Rhs>;
+					if constexpr(std::is_same_v<lhs_t, rhs_t> && std::is_integral_v<lhs_t> &&
+								 std::is_same_v<Compare, std::equal_to<>>)
+					{
+						if(std::memcmp(data, std::ranges::data(rhs), size * sizeof(lhs_t)) == 0) return 0u;
+					}
+
+					const auto* other = std::ranges::data(rhs);
+					size_t failures{0};
+					for(size_t i = 0; i < size; ++i) failures += static_cast<size_t>(!compare(data[i], other[i]));
+					return failures;
+				}
+				else
+				{
+					size_t failures{0};
+					for(size_t i = 0; i < size; ++i)
+						failures += static_cast<size_t>(!compare(data[i], range_rhs_at(rhs, i)));
+					return failures;
+				}
+			}
+			else
+			{
+				auto it = std::ranges::begin(lhs);
+				size_t failures{0};
+				for(size_t i = 0; i < size; ++i) failures += static_cast<size_t>(!compare(it[i], range_rhs_at(rhs, i)));
+				return failures;
+			}
+		}
+
+		template <bool Fatal>
+		void log_range_expect(std::string lhs, std::string rhs, bool res,
+							  test_result_t::expect_t::operation_t operation, const source_location& location,
+							  const std::string& summary) noexcept
+		{
+			if(tallied(res) || aggregated<Fatal>(res, location)) return;
+			std::string lhs_user{};
+			std::string rhs_user{};
+			evaluate(location, operation, (Fatal) ? "require_range" : "expect_range", lhs_user, rhs_user);
+			auto info = (expect_info.message.empty()) ? summary : combine_text(expect_info.message, " ", summary);
+			record_expect(lhs, rhs, lhs_user, rhs_user, operation, res, Fatal, info);
+			expect_info.message = {};
+
+			suite_context.output.fatal = !res && Fatal;
+		}
+
+		/*
+			bulk expectation over a range, the elements are compared against another range, a single value, or a
+			predicate. A single result is recorded for the entire range, which on failure holds the values of the
+			first `LITMUS_RANGE_MISMATCHES` failing elements and their indices.
+		*/
+		template <bool Fatal, typename R>
+		class expect_range_t
+		{
+			static_assert(IsCheckedRange<std::remove_cvref_t<R>>, "expect_range requires a sized random access range");
+
+		  public:
+			template <typename Y>
+			constexpr expect_range_t(const source_location& source, Y&& range) noexcept
+				: m_Range(std::forward<Y>(range)), m_Source(source)
+			{}
+
+			[[maybe_unused]] auto operator==(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::equal_to<>{}, test_result_t::expect_t::operation_t::equal);
+			}
+			[[maybe_unused]] auto operator!=(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::not_equal_to<>{}, test_result_t::expect_t::operation_t::inequal);
+			}
+			[[maybe_unused]] auto operator<(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::less<>{}, test_result_t::expect_t::operation_t::less_than);
+			}
+			[[maybe_unused]] auto operator>(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::greater<>{}, test_result_t::expect_t::operation_t::greater_than);
+			}
+			[[maybe_unused]] auto operator<=(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::less_equal<>{}, test_result_t::expect_t::operation_t::less_equal);
+			}
+			[[maybe_unused]] auto operator>=(const auto& rhs) const noexcept -> bool
+			{
+				return compare(rhs, std::greater_equal<>{}, test_result_t::expect_t::operation_t::greater_equal);
+			}
+
+			template <typename Predicate>
+			[[maybe_unused]] auto operator==(const satisfies_t<Predicate>& rhs) const noexcept -> bool
+			{
+				return compare(
+					rhs, [](const auto& value, const auto& pred) -> bool { return pred.predicate(value); },
+					test_result_t::expect_t::operation_t::equal);
+			}
+			template <typename Predicate>
+			[[maybe_unused]] auto operator!=(const satisfies_t<Predicate>& rhs) const noexcept -> bool
+			{
+				return compare(
+					rhs, [](const auto& value, const auto& pred) -> bool { return !pred.predicate(value); },
+					test_result_t::expect_t::operation_t::inequal);
+			}
+
+			/*
+				element wise tolerance check, next to the failing elements the result reports the largest error in
+				ulps along with its index, and the mean absolute error over the entire range.
+			*/
+			template <typename T>
+				requires(IsCheckedRange<std::remove_cvref_t<T>>)
+			[[maybe_unused]] auto operator==(const approx_t<T>& rhs) const noexcept -> bool
+			{
+				constexpr auto operation = test_result_t::expect_t::operation_t::equal;
+				if(suite_context.output.fatal) return false;
+				const auto& expected = rhs.value();
+				if(!sizes_match(expected, operation)) return false;
+
+				using lhs_t	   = std::ranges::range_value_t<std::remove_cvref_t<R>>;
+				using rhs_t	   = std::ranges::range_value_t<std::remove_cvref_t<T>>;
+				using common_t = std::common_type_t<lhs_t, rhs_t>;
+				const auto size = static_cast<size_t>(std::ranges::size(m_Range));
+				auto lhs_it		= std::ranges::begin(m_Range);
+				auto rhs_it		= std::ranges::begin(expected);
+
+				// selects instead of branches, so the loop stays vectorizable
+				size_t failures{0};
+				size_t worst{0};
+				std::uint64_t max_ulps{0};
+				double total_error{0};
+				for(size_t i = 0; i < size; ++i)
+				{
+					const auto a	= static_cast<common_t>(lhs_it[i]);
+					const auto b	= static_cast<common_t>(rhs_it[i]);
+					const auto ulps = ulp_distance(a, b);
+					failures += static_cast<size_t>(!rhs.within(a, b));
+					worst		= (ulps > max_ulps) ? i : worst;
+					max_ulps	= (ulps > max_ulps) ? ulps : max_ulps;
+					total_error += std::abs(static_cast<double>(a) - static_cast<double>(b));
+				}
+
+				const bool res{failures == 0};
+				trigger_break(res, Fatal);
+				const auto mean_error = (size > 0) ? total_error / static_cast<double>(size) : 0.0;
+				auto summary = combine_text("max error of ", std::to_string(max_ulps), " ulps at [",
+											std::to_string(worst), "], mean error ", error_to_string(mean_error));
+				if(res)
+				{
+					log_range_expect<Fatal>(combine_text(std::to_string(size), " elements"), to_string_fn(rhs), res,
+											operation, m_Source, summary);
+					return res;
+				}
+
+				std::vector<std::string> lhs_values{};
+				std::vector<std::string> indices{};
+				for(size_t i = 0; i < size && indices.size() < LITMUS_RANGE_MISMATCHES; ++i)
+				{
+					if(rhs.within(lhs_it[i], rhs_it[i])) continue;
+					lhs_values.emplace_back(to_string_fn(lhs_it[i]));
+					indices.emplace_back(std::to_string(i));
+				}
+				log_range_expect<Fatal>("{" + join(lhs_values, ", ") + "}", to_string_fn(rhs), res, operation,
+										m_Source,
+										combine_text(std::to_string(failures), " of ", std::to_string(size),
+													 " elements failed, first at [", join(indices, ", "), "], ",
+													 summary));
+				return res;
+			}
+
+		  private:
+			// logs a failure when the sizes differ, element wise comparisons require equally sized ranges
+			auto sizes_match(const auto& rhs, test_result_t::expect_t::operation_t operation) const noexcept -> bool
+			{
+				const auto size		= static_cast<size_t>(std::ranges::size(m_Range));
+				const auto rhs_size = static_cast<size_t>(std::ranges::size(rhs));
+				if(size == rhs_size) return true;
+
+				trigger_break(false, Fatal);
+				log_range_expect<Fatal>(combine_text(std::to_string(size), " elements"),
+										combine_text(std::to_string(rhs_size), " elements"), false, operation,
+										m_Source, "range sizes differ");
+				return false;
+			}
+
+			template <typename Rhs, typename Compare>
+			auto compare(const Rhs& rhs, Compare compare, test_result_t::expect_t::operation_t operation) const noexcept
+				-> bool
+			{
+				if(suite_context.output.fatal) return false;
+				const auto size = static_cast<size_t>(std::ranges::size(m_Range));
+				if constexpr(IsCheckedRange<Rhs>)
+				{
+					if(!sizes_match(rhs, operation)) return false;
+				}
+
+				const auto failures = count_range_failures(m_Range, rhs, compare, size);
+				const bool res{failures == 0};
+				trigger_break(res, Fatal);
+				if(res)
+				{
+					const auto elements = combine_text(std::to_string(size), " elements");
+					if constexpr(IsCheckedRange<Rhs>)
+						log_range_expect<Fatal>(elements, elements, res, operation, m_Source, {});
+					else
+						log_range_expect<Fatal>(elements, to_string_fn(rhs), res, operation, m_Source, {});
+					return res;
+				}
+
+				// only the failing elements that are reported get converted to strings
+				std::vector<std::string> lhs_values{};
+				std::vector<std::string> rhs_values{};
+				std::vector<std::string> indices{};
+				auto it = std::ranges::begin(m_Range);
+				for(size_t i = 0; i < size && indices.size() < LITMUS_RANGE_MISMATCHES; ++i)
+				{
+					if(compare(it[i], range_rhs_at(rhs, i))) continue;
+					lhs_values.emplace_back(to_string_fn(it[i]));
+					if constexpr(IsCheckedRange<Rhs>) rhs_values.emplace_back(to_string_fn(range_rhs_at(rhs, i)));
+					indices.emplace_back(std::to_string(i));
+				}
+
+				std::string rhs_value{};
+				if constexpr(IsCheckedRange<Rhs>)
+					rhs_value = "{" + join(rhs_values, ", ") + "}";
+				else
+					rhs_value = to_string_fn(rhs);
+				log_range_expect<Fatal>("{" + join(lhs_values, ", ") + "}", rhs_value, res, operation, m_Source,
+										combine_text(std::to_string(failures), " of ", std::to_string(size),
+													 " elements failed, first at [", join(indices, ", "), "]"));
+				return res;
+			}
+
+			R m_Range;
+			source_location m_Source;
+		};
+	} // namespace internal
+
+	template <typename R>
+	struct expect_range : public expect_range_t<false, R>
+	{
+		using base = expect_range_t<false, R>;
+		expect_range(R&& range, const source_location& loc = source_location::current())
+			: base(loc, std::forward<R>(range))
+		{}
+	};
+
+	template <typename R>
+	expect_range(R&&) -> expect_range<R>;
+
+	template <typename R>
+	struct require_range : public expect_range_t<true, R>
+	{
+		using base = expect_range_t<true, R>;
+		require_range(R&& range, const source_location& loc = source_location::current())
+			: base(loc, std::forward<R>(range))
+		{}
+	};
+
+	template <typename R>
+	require_range(R&&) -> require_range<R>;
+} // namespace litmus
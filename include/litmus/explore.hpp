@@ -0,0 +1,354 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <litmus/details/explorer.hpp>
+#include <litmus/details/random.hpp>
+#include <litmus/suite.hpp>
+#include <litmus/thread.hpp>
+
+namespace litmus
+{
+	/*
+		primitives of explored suites, see `suite<...>().explore()`. Outside of an explored suite they behave like
+		their standard counterparts.
+	*/
+	namespace explore
+	{
+		// lets the explorer switch to another thread
+		inline void yield() noexcept
+		{
+			if(auto* explorer = explorer_t::current(); explorer != nullptr) explorer->yield();
+		}
+
+		/*
+			`std::atomic` with a yield point in front of every operation. Explored threads only run one at a time,
+			so every interleaving of the operations is sequentially consistent, weaker memory orders are not
+			simulated.
+		*/
+		template <typename T>
+		class atomic
+		{
+		  public:
+			using value_type = T;
+
+			constexpr atomic() noexcept = default;
+			constexpr atomic(T value) noexcept : m_Value(value) {}
+			atomic(const atomic&) = delete;
+
+			auto operator=(const atomic&) -> atomic& = delete;
+			auto operator=(T value) noexcept -> T
+			{
+				store(value);
+				return value;
+			}
+
+			operator T() const noexcept { return load(); }
+
+			[[nodiscard]] auto load(std::memory_order order = std::memory_order_seq_cst) const noexcept -> T
+			{
+				yield();
+				return m_Value.load(order);
+			}
+
+			void store(T value, std::memory_order order = std::memory_order_seq_cst) noexcept
+			{
+				yield();
+				m_Value.store(value, order);
+			}
+
+			auto exchange(T value, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+			{
+				yield();
+				return m_Value.exchange(value, order);
+			}
+
+			auto compare_exchange_weak(T& expected, T desired, std::memory_order success,
+									   std::memory_order failure) noexcept -> bool
+			{
+				yield();
+				return m_Value.compare_exchange_weak(expected, desired, success, failure);
+			}
+
+			auto compare_exchange_weak(T& expected, T desired,
+									   std::memory_order order = std::memory_order_seq_cst) noexcept -> bool
+			{
+				yield();
+				return m_Value.compare_exchange_weak(expected, desired, order);
+			}
+
+			auto compare_exchange_strong(T& expected, T desired, std::memory_order success,
+										 std::memory_order failure) noexcept -> bool
+			{
+				yield();
+				return m_Value.compare_exchange_strong(expected, desired, success, failure);
+			}
+
+			auto compare_exchange_strong(T& expected, T desired,
+										 std::memory_order order = std::memory_order_seq_cst) noexcept -> bool
+			{
+				yield();
+				return m_Value.compare_exchange_strong(expected, desired, order);
+			}
+
+			template <typename Y>
+				requires(requires(std::atomic<T>& value, Y arg) { value.fetch_add(arg); })
+			auto fetch_add(Y arg, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+			{
+				yield();
+				return m_Value.fetch_add(arg, order);
+			}
+
+			template <typename Y>
+				requires(requires(std::atomic<T>& value, Y arg) { value.fetch_sub(arg); })
+			auto fetch_sub(Y arg, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+			{
+				yield();
+				return m_Value.fetch_sub(arg, order);
+			}
+
+			auto fetch_and(T arg, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+				requires(std::is_integral_v<T>)
+			{
+				yield();
+				return m_Value.fetch_and(arg, order);
+			}
+
+			auto fetch_or(T arg, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+				requires(std::is_integral_v<T>)
+			{
+				yield();
+				return m_Value.fetch_or(arg, order);
+			}
+
+			auto fetch_xor(T arg, std::memory_order order = std::memory_order_seq_cst) noexcept -> T
+				requires(std::is_integral_v<T>)
+			{
+				yield();
+				return m_Value.fetch_xor(arg, order);
+			}
+
+			auto operator++() noexcept -> T { return fetch_add(1) + 1; }
+			auto operator--() noexcept -> T { return fetch_sub(1) - 1; }
+			auto operator++(int) noexcept -> T { return fetch_add(1); }
+			auto operator--(int) noexcept -> T { return fetch_sub(1); }
+
+		  private:
+			std::atomic<T> m_Value{};
+		};
+
+		/*
+			thread that is scheduled by the explorer of the suite that started it, its expects are recorded in that
+			suite. Joins when it goes out of scope.
+		*/
+		class thread
+		{
+		  public:
+			thread() noexcept = default;
+
+			template <typename Fn, typename... Args>
+				requires(!std::is_same_v<std::remove_cvref_t<Fn>, thread>)
+			explicit thread(Fn&& fn, Args&&... args)
+			{
+				auto* explorer = explorer_t::current();
+				if(explorer == nullptr)
+				{
+					m_Thread = litmus::thread{std::forward<Fn>(fn), std::forward<Args>(args)...};
+					return;
+				}
+
+				// shared, so the scheduled body stays copyable for move only callables and arguments
+				auto state = std::make_shared<std::tuple<std::decay_t<Fn>, std::decay_t<Args>...>>(
+					std::forward<Fn>(fn), std::forward<Args>(args)...);
+				auto body = [context = capture_context(), state]() {
+					attach_context attached{context};
+					std::apply([](auto& fn, auto&... args) { std::invoke(std::move(fn), std::move(args)...); },
+							   *state);
+				};
+				m_Explorer = explorer;
+				m_Index	   = explorer->spawn(std::move(body));
+			}
+
+			thread(thread&& other) noexcept
+				: m_Thread(std::move(other.m_Thread)), m_Explorer(std::exchange(other.m_Explorer, nullptr)),
+				  m_Index(other.m_Index)
+			{}
+			auto operator=(thread&& other) noexcept -> thread&
+			{
+				if(this != &other)
+				{
+					if(joinable()) join();
+					m_Thread   = std::move(other.m_Thread);
+					m_Explorer = std::exchange(other.m_Explorer, nullptr);
+					m_Index	   = other.m_Index;
+				}
+				return *this;
+			}
+			~thread()
+			{
+				if(joinable()) join();
+			}
+
+			void join()
+			{
+				if(m_Explorer == nullptr) return m_Thread.join();
+				std::exchange(m_Explorer, nullptr)->join(m_Index);
+			}
+			[[nodiscard]] auto joinable() const noexcept -> bool
+			{
+				return m_Explorer != nullptr || m_Thread.joinable();
+			}
+
+		  private:
+			litmus::thread m_Thread{};
+			explorer_t* m_Explorer{nullptr};
+			size_t m_Index{0};
+		};
+	} // namespace explore
+
+	inline namespace internal
+	{
+		template <typename Fn, typename Args, typename... InvokeTypes>
+		class explore_permutations_t final : public permutations_t
+		{
+		  public:
+			explore_permutations_t(Fn fn, Args args, const char* name, const source_location& location,
+								   std::vector<const char*> categories, size_t schedules, explore_strategy_t strategy)
+				: m_Fn(std::move(fn)), m_Args(std::move(args)), m_Name(name), m_Location(location),
+				  m_Categories(std::move(categories)), m_Size(permutation_count(m_Args)), m_Schedules(schedules),
+				  m_Strategy(strategy)
+			{}
+
+			[[nodiscard]] auto size() const noexcept -> size_t override { return m_Size; }
+
+			/*
+				runs the suite once per schedule, and stops at the first schedule that fails. On success only an
+				aggregate record is kept, on failure the record of the failing schedule is kept, with the seed and
+				interleaving that reproduce it.
+			*/
+			[[nodiscard]] auto run(size_t index) const -> test_result_t override
+			{
+				suite_context = {};
+				if(!categories_selected(m_Categories)) return suite_context.output;
+
+				const auto values = resolve_fixtures(permutation_at(m_Args, index));
+				const auto seed	  = config->seed ^ hash_string(m_Name) ^ (index * 0x9E3779B97F4A7C15u);
+				const std::string strategy_name{(m_Strategy == explore_strategy_t::random) ? "random" : "exhaustive"};
+
+				const auto start = timing::now();
+				std::vector<size_t> prefix{};
+				size_t pass{0};
+				size_t schedules{0};
+				while(schedules < m_Schedules)
+				{
+					explorer_t explorer{m_Strategy, seed + schedules, std::move(prefix)};
+					++schedules;
+					suite_context = {};
+					suite_context.output.scope_open(m_Name, {}, m_Location);
+					explorer.run([this, &values]() { suite_functor::invoke_sections<InvokeTypes...>(m_Fn, values); });
+					if(explorer.exceeded())
+						suite_context.output.expect_result(std::to_string(explorer.steps()),
+														   std::to_string(LITMUS_EXPLORE_MAX_STEPS), "explored steps",
+														   "LITMUS_EXPLORE_MAX_STEPS",
+														   test_result_t::expect_t::operation_t::less_equal, false,
+														   false, "the schedule took too many steps");
+					suite_context.output.scope_close();
+					suite_context.output.sync();
+
+					if(suite_context.output.fails || suite_context.output.fatal)
+					{
+						auto& root		= std::get<test_result_t::scope_t>(suite_context.output.results[0]);
+						root.parameters = describe(index);
+						root.parameters.emplace_back(combine_text(
+							"schedule ", std::to_string(schedules), "/", std::to_string(m_Schedules), " (",
+							strategy_name, "), --seed ", std::to_string(config->seed), ", interleaving ",
+							explorer.describe()));
+						return suite_context.output;
+					}
+					pass += suite_context.output.root().pass;
+
+					if(m_Strategy == explore_strategy_t::exhaustive)
+					{
+						auto next = explorer_t::next_prefix(explorer.decisions());
+						if(!next) break;
+						prefix = std::move(*next);
+					}
+				}
+
+				test_result_t report{};
+				report.scope_open(m_Name, {}, m_Location);
+				report.scope_results(0, pass, 0, 0);
+				report.scope_close();
+				auto& root		= std::get<test_result_t::scope_t>(report.results[0]);
+				root.parameters = describe(index);
+				root.parameters.emplace_back(combine_text(std::to_string(schedules), " schedules (", strategy_name,
+														  "), --seed ", std::to_string(config->seed)));
+				root.start = start;
+				return report;
+			}
+
+			void start(size_t index, event_loop_t&, test_result_t& result) const override { result = run(index); }
+
+			[[nodiscard]] auto describe(size_t index) const -> std::vector<std::string> override
+			{
+				const auto values = permutation_at(m_Args, index);
+				return pack_to_string<std::tuple_size_v<std::remove_cvref_t<decltype(values)>>>(values);
+			}
+
+			[[nodiscard]] auto location() const noexcept -> const source_location& override { return m_Location; }
+			[[nodiscard]] auto categories() const noexcept -> std::span<const char* const> override
+			{
+				return m_Categories;
+			}
+
+		  private:
+			using values_t = decltype(permutation_at(std::declval<const Args&>(), 0));
+			using traits_t = argument_traits<values_t>;
+			using result_t = decltype(suite_functor::call<InvokeTypes...>(
+				std::declval<const Fn&>(), std::declval<const typename invoked_values<values_t>::type&>()));
+			static_assert(!traits_t::has_property && !traits_t::has_stream,
+						  "explored suites do not support property generators or stream arguments");
+			static_assert(!IsTask<std::remove_cvref_t<result_t>>, "explored suites cannot be coroutines");
+
+			Fn m_Fn;
+			Args m_Args;
+			const char* m_Name;
+			source_location m_Location;
+			std::vector<const char*> m_Categories;
+			size_t m_Size;
+			size_t m_Schedules;
+			explore_strategy_t m_Strategy;
+		};
+
+		// registers suites that were marked with `.explore()`, '--fork-sections' does not apply to them
+		struct explore_functor
+		{
+			static constexpr bool supports_generators = true;
+			static constexpr bool supports_templates  = true;
+
+			size_t schedules{100};
+			explore_strategy_t strategy{explore_strategy_t::random};
+
+			bool should_run() noexcept { return true; }
+
+			template <typename... InvokeTypes, typename... Ts>
+			void operator()(auto& fn, const char* name, const source_location& location,
+							const std::vector<const char*>& categories, const std::tuple<Ts...>& args)
+			{
+				using args_t		 = std::tuple<std::remove_cvref_t<Ts>...>;
+				using permutations = explore_permutations_t<std::remove_cvref_t<decltype(fn)>, args_t, InvokeTypes...>;
+				runner.template test<InvokeTypes...>(
+					name, std::make_unique<const permutations>(fn, args_t{args}, name, location, categories,
+															   schedules, strategy));
+			}
+		};
+	} // namespace internal
+} // namespace litmus
@@ -0,0 +1,176 @@
+#pragma once
+#include <concepts>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+
+#include <litmus/details/scope.hpp>
+
+#include "strtype/strtype.hpp"
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		// keeps a constructed fixture value alive while the suite that requested it runs
+		template <typename T>
+		class fixture_ref_t
+		{
+		  public:
+			constexpr static bool is_fixture_ref{true};
+
+			fixture_ref_t(std::shared_ptr<const T> value) noexcept : m_Value(std::move(value)) {}
+
+			[[nodiscard]] auto get() const noexcept -> const T& { return *m_Value; }
+
+			[[nodiscard]] auto describe() const -> std::string
+			{
+				return "fixture<" + std::string{strtype::stringify_typename<T>()} + ">";
+			}
+
+		  private:
+			std::shared_ptr<const T> m_Value;
+		};
+	} // namespace internal
+
+	/*
+		lazily constructed value that is shared by every section replay and permutation of the suites it is passed
+		to, the suite receives it as `const T&`. When the factory takes no arguments the value is constructed once,
+		otherwise it is invoked with the other arguments of the permutation (generator values) and a value is cached
+		per unique set of arguments. Every value is constructed by the first suite that requests it, suites running in
+		parallel wait for that value only, and not for the construction of other values. An exception thrown by the
+		factory is rethrown to every suite that requests the value, until the fixture is invalidated.
+	*/
+	template <typename Factory>
+	class fixture
+	{
+		template <typename... Keys>
+		using value_t = std::remove_cvref_t<std::invoke_result_t<const Factory&, const Keys&...>>;
+
+		template <typename... Keys>
+		using future_t = std::shared_future<std::shared_ptr<const value_t<Keys...>>>;
+
+		struct state_t
+		{
+			std::mutex lock{};
+			std::shared_ptr<void> value{};
+			// one cache per set of key types, as the fixture can be shared by suites with different arguments
+			std::map<std::type_index, std::shared_ptr<void>> keyed{};
+		};
+
+	  public:
+		constexpr static bool is_fixture{true};
+
+		fixture(Factory factory) : m_Factory(std::move(factory)), m_State(std::make_shared<state_t>()) {}
+
+		// returns the cached value, constructing it on first use
+		template <typename... Keys>
+			requires(std::invocable<const Factory&, const Keys&...>)
+		[[nodiscard]] auto get(const Keys&... keys) const -> fixture_ref_t<value_t<Keys...>>
+		{
+			using type = value_t<Keys...>;
+			std::unique_lock<std::mutex> guard{m_State->lock};
+			auto& entry = [&]() -> future_t<Keys...>& {
+				if constexpr(sizeof...(Keys) == 0)
+				{
+					if(!m_State->value) m_State->value = std::make_shared<future_t<>>();
+					return *std::static_pointer_cast<future_t<>>(m_State->value);
+				}
+				else
+				{
+					using cache_t = std::map<std::tuple<Keys...>, future_t<Keys...>>;
+					auto& storage = m_State->keyed[std::type_index{typeid(cache_t)}];
+					if(!storage) storage = std::make_shared<cache_t>();
+					return (*std::static_pointer_cast<cache_t>(storage))[std::tuple<Keys...>{keys...}];
+				}
+			}();
+
+			// the entry can be dropped by `invalidate` once the lock is released, only the copy is used from there on
+			if(entry.valid())
+			{
+				auto value = entry;
+				guard.unlock();
+				return {value.get()};
+			}
+
+			std::promise<std::shared_ptr<const type>> promise{};
+			entry	   = promise.get_future().share();
+			auto value = entry;
+			guard.unlock();
+			try
+			{
+				promise.set_value(std::make_shared<const type>(std::invoke(m_Factory, keys...)));
+			}
+			catch(...)
+			{
+				promise.set_exception(std::current_exception());
+			}
+			return {value.get()};
+		}
+
+		// drops the cached value(s), the next suite to request the fixture constructs it again
+		void invalidate() const
+		{
+			std::lock_guard<std::mutex> guard{m_State->lock};
+			m_State->value.reset();
+			m_State->keyed.clear();
+		}
+
+		[[nodiscard]] auto describe() const -> std::string { return "fixture"; }
+
+	  private:
+		Factory m_Factory;
+		std::shared_ptr<state_t> m_State;
+	};
+
+	inline namespace internal
+	{
+		// the value handed to the suite for an argument, fixtures are passed by const reference
+		template <typename T>
+		[[nodiscard]] constexpr auto fixture_value(const T& value) noexcept -> const auto&
+		{
+			if constexpr(IsFixtureRef<T>)
+				return value.get();
+			else
+				return value;
+		}
+
+		/*
+			replaces the fixtures in the decoded arguments of a permutation by a reference to their value, keyed
+			fixtures receive the remaining arguments.
+		*/
+		template <typename... Ts>
+		[[nodiscard]] auto resolve_fixtures(const std::tuple<Ts...>& values)
+		{
+			const auto keys = [&values]<size_t... N>(std::index_sequence<N...>) {
+				return std::tuple_cat([&]() {
+					if constexpr(IsFixture<Ts>)
+						return std::tuple<>{};
+					else
+						return std::tuple<const Ts&>{std::get<N>(values)};
+				}()...);
+			}(std::index_sequence_for<Ts...>{});
+
+			auto resolve = [&]<size_t N>(std::integral_constant<size_t, N>) {
+				using type = std::tuple_element_t<N, std::tuple<Ts...>>;
+				if constexpr(!IsFixture<type>)
+					return std::get<N>(values);
+				else if constexpr(requires(const type& value) { value.get(); })
+					return std::get<N>(values).get();
+				else
+					return std::apply([&](const auto&... key) { return std::get<N>(values).get(key...); }, keys);
+			};
+			return [&]<size_t... N>(std::index_sequence<N...>) {
+				return std::tuple<decltype(resolve(std::integral_constant<size_t, N>{}))...>{
+					resolve(std::integral_constant<size_t, N>{})...};
+			}(std::index_sequence_for<Ts...>{});
+		}
+	} // namespace internal
+} // namespace litmus
@@ -1,6 +1,8 @@
 #pragma once
 #include <chrono>
+#include <memory>
 #include <ostream>
+#include <string_view>
 #include <litmus/details/source_location.hpp>
 #include <litmus/details/test_result.hpp>
 
@@ -35,6 +37,8 @@ namespace litmus
 		{}
 		virtual void suite_iterate_templates([[maybe_unused]] const std::vector<std::string>& templates) {}
 		virtual void suite_iterate_parameters([[maybe_unused]] const std::vector<std::string>& parameters) {}
+		// the latencies of a benchmark permutation, after its parameters
+		virtual void suite_iterate_measurement([[maybe_unused]] const test_result_t::measurement_t& measurement) {}
 
 		virtual void scope_begin([[maybe_unused]] const test_result_t::scope_t& scope) {}
 
@@ -57,6 +61,18 @@ namespace litmus
 
 		void flush() { output() << std::flush; }
 
+		/*
+			a copy that writes to `stream`, so suites can be formatted on the threads that ran them. Formatters that
+			carry state from one suite to the next return nullptr, their suites are formatted one after the other.
+		*/
+		[[nodiscard]] virtual auto clone([[maybe_unused]] std::ostream& stream) const -> std::unique_ptr<formatter>
+		{
+			return nullptr;
+		}
+
+		// writes the output a clone formatted
+		void append(std::string_view formatted) { output() << formatted; }
+
 	  protected:
 		std::ostream& output() { return *m_Output; }
 		bool is_console() const noexcept { return m_IsConsole; }
@@ -6,6 +6,13 @@ namespace litmus::formatters
 	class compact final : public litmus::formatter
 	{
 	  public:
+		[[nodiscard]] auto clone(std::ostream& stream) const -> std::unique_ptr<litmus::formatter> override
+		{
+			auto res	  = std::make_unique<compact>(*this);
+			res->m_Output = &stream;
+			return res;
+		}
+
 		void scope_begin(const test_result_t::scope_t& scope) override
 		{
 			if(!log_suite) return;
@@ -25,10 +32,12 @@ namespace litmus::formatters
 				parameters = dim(italics(combine_text(" [ ", std::move(parameters), " ]")));
 			}
 
-			auto duration_str = std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
-												   scope.duration_end - scope.duration_start)
-												   .count()) +
-								"μs ";
+			// scopes that were not timed ('--timing <clock> suites') have no duration to show
+			auto duration_str =
+				(scope.end == 0u)
+					? std::string{}
+					: std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(scope.duration()).count()) +
+						  "μs ";
 
 			auto lhs = combine_text(std::string((scope.id.size() + extra_depth) * 2, ' '), bold(scope.name),
 									std::move(parameters));
@@ -113,7 +122,7 @@ namespace litmus::formatters
 				colour(combine_text(outcome[outcome_index],
 									((outcome_index == 2) ? std::string_view("=> ") : std::string_view(" => "))),
 					   style_colours[outcome_index]),
-									  codeblock),
+									  codeblock, expect.repeats_text()),
 						 "\n");
 		}
 
@@ -181,6 +190,14 @@ namespace litmus::formatters
 
 			output() << (pstr);
 		}
+		void suite_iterate_measurement(const test_result_t::measurement_t& measurement) override
+		{
+			if(!log_suite) return;
+			extra_depth = (has_templates) ? 2u : 1u;
+			output() << "\n";
+			output() << italics(combine_text(std::string(extra_depth * 2u, ' '), colour("measured { ", 99, 242, 249),
+											 measurement.to_string(), colour(" }", 99, 242, 249)));
+		}
 
 		std::string time_to_string(std::chrono::microseconds duration)
 		{
@@ -11,6 +11,13 @@ namespace litmus::formatters
 {
 	class detailed_stream_formatter_no_color final : public litmus::formatter
 	{
+		[[nodiscard]] auto clone(std::ostream& stream) const -> std::unique_ptr<litmus::formatter> override
+		{
+			auto res	  = std::make_unique<detailed_stream_formatter_no_color>(*this);
+			res->m_Output = &stream;
+			return res;
+		}
+
 		void scope_begin(const test_result_t::scope_t& scope) override
 		{
 			const size_t style_index = (scope.fatal > 0) ? 2 : (scope.fail > 0) ? 1 : (scope.pass > 0) ? 0 : 3;
@@ -26,10 +33,12 @@ namespace litmus::formatters
 				parameters = combine_text(" [ ", std::move(parameters), " ]");
 			}
 
-			auto duration_str = std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
-												   scope.duration_end - scope.duration_start)
-												   .count()) +
-								"μs ";
+			// scopes that were not timed ('--timing <clock> suites') have no duration to show
+			auto duration_str =
+				(scope.end == 0u)
+					? std::string{}
+					: std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(scope.duration()).count()) +
+						  "μs ";
 
 			auto lhs =
 				combine_text(std::string((scope.id.size() + extra_depth) * 2, ' '), scope.name, std::move(parameters));
@@ -104,7 +113,7 @@ namespace litmus::formatters
 				combine_text(outcome[outcome_index],
 							 ((outcome_index == 2) ? std::string_view("=> ") : std::string_view(" => "))),
 
-				codeblock, '\n'));
+				codeblock, expect.repeats_text(), '\n'));
 		}
 
 		void suite_begin(const char* name, size_t pass, size_t fail, size_t fatal,
@@ -159,6 +168,12 @@ namespace litmus::formatters
 
 			output() << (pstr);
 		}
+		void suite_iterate_measurement(const test_result_t::measurement_t& measurement) override
+		{
+			extra_depth = (has_templates) ? 2u : 1u;
+			output() << combine_text(std::string(extra_depth * 2u, ' '), "measured { ", measurement.to_string(),
+									 " }\n");
+		}
 
 		std::string time_to_string(std::chrono::microseconds duration)
 		{
@@ -212,6 +227,14 @@ namespace litmus::formatters
 	{
 	  public:
 		detailed_stream_formatter() noexcept = default;
+
+		[[nodiscard]] auto clone(std::ostream& stream) const -> std::unique_ptr<litmus::formatter> override
+		{
+			auto res	  = std::make_unique<detailed_stream_formatter>(*this);
+			res->m_Output = &stream;
+			return res;
+		}
+
 		void scope_begin(const test_result_t::scope_t& scope) override
 		{
 			const size_t style_index = (scope.fatal > 0) ? 2 : (scope.fail > 0) ? 1 : (scope.pass > 0) ? 0 : 3;
@@ -227,10 +250,12 @@ namespace litmus::formatters
 				parameters = dim(italics(combine_text(" [ ", std::move(parameters), " ]")));
 			}
 
-			auto duration_str = std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
-												   scope.duration_end - scope.duration_start)
-												   .count()) +
-								"μs ";
+			// scopes that were not timed ('--timing <clock> suites') have no duration to show
+			auto duration_str =
+				(scope.end == 0u)
+					? std::string{}
+					: std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(scope.duration()).count()) +
+						  "μs ";
 
 			auto lhs = combine_text(std::string((scope.id.size() + extra_depth) * 2, ' '), bold(scope.name),
 									std::move(parameters));
@@ -311,7 +336,7 @@ namespace litmus::formatters
 				colour(combine_text(outcome[outcome_index],
 									((outcome_index == 2) ? std::string_view("=> ") : std::string_view(" => "))),
 					   style_colours[outcome_index]),
-				codeblock, '\n'));
+				codeblock, expect.repeats_text(), '\n'));
 		}
 
 		void suite_begin(const char* name, size_t pass, size_t fail, size_t fatal,
@@ -369,6 +394,12 @@ namespace litmus::formatters
 
 			output() << (pstr);
 		}
+		void suite_iterate_measurement(const test_result_t::measurement_t& measurement) override
+		{
+			extra_depth = (has_templates) ? 2u : 1u;
+			output() << italics(combine_text(std::string(extra_depth * 2u, ' '), colour("measured { ", 99, 242, 249),
+											 measurement.to_string(), colour(" }\n", 99, 242, 249)));
+		}
 
 		std::string time_to_string(std::chrono::microseconds duration)
 		{
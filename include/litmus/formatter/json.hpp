@@ -1,4 +1,9 @@
 #pragma once
+#include <charconv>
+#include <iterator>
+#include <string>
+#include <vector>
+
 #include <litmus/formatter.hpp>
 
 namespace litmus::formatters
@@ -6,29 +11,68 @@ namespace litmus::formatters
 	class json final : public litmus::formatter
 	{
 	  public:
-		void begin(size_t tests) override { m_Tests = tests; }
 		void suite_begin(const char* name, size_t pass, size_t fail, size_t fatal, const source_location& location,
 						 std::chrono::microseconds duration) override
 		{
-			if(m_Iteration == 0u) output() << "[";
+			output() << ((m_Iteration == 0u) ? "[" : ",\n");
 			output() << "{\n\t\"name\": \"" << name << "\",\n\t\"pass\": " << std::to_string(pass)
 					 << ",\n\t\"fail\": " << std::to_string(fail) << ",\n\t\"fatal\": " << std::to_string(fatal)
 					 << ",\n\t\"source\": \"" << location.file_name() << ":" << std::to_string(location.line())
 					 << "\",\n\t\"duration_microseconds\": " << std::to_string(duration.count()) << ",\n\t\"tests\": [";
 			++m_Iteration;
+			m_Permutation = 0u;
+			m_Measured	  = 0u;
+		}
+
+		void suite_iterate([[maybe_unused]] const std::vector<std::string>& templates,
+						   [[maybe_unused]] const std::vector<std::string>& parameters) override
+		{
+			++m_Permutation;
+		}
+
+		// benchmark permutations are written as numbers, the latencies are in nanoseconds
+		void suite_iterate_measurement(const test_result_t::measurement_t& measurement) override
+		{
+			auto number = [](double value) {
+				char buffer[32]{};
+				const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+				return std::string{buffer, result.ptr};
+			};
+
+			output() << ((m_Measured++ == 0u) ? "\n\t\t{" : ",\n\t\t{") << "\"permutation\": " << (m_Permutation - 1u)
+					 << ", \"operations\": " << measurement.operations << ", \"mean\": " << number(measurement.mean)
+					 << ", \"p50\": " << number(measurement.p50) << ", \"p90\": " << number(measurement.p90)
+					 << ", \"p99\": " << number(measurement.p99) << ", \"p99.9\": " << number(measurement.p999)
+					 << ", \"max\": " << number(measurement.max) << ", \"rate\": " << number(measurement.rate)
+					 << ", \"samples\": " << measurement.samples
+					 << ", \"dispersion\": " << number(measurement.dispersion)
+					 << ", \"attempts\": " << measurement.attempts
+					 << ", \"noisy\": " << ((measurement.noisy) ? "true" : "false");
+			if(!measurement.complexity.empty())
+				output() << ", \"complexity\": \"" << measurement.complexity
+						 << "\", \"rms\": " << number(measurement.rms);
+			output() << "}";
+		}
+
+		void suite_end([[maybe_unused]] const char* name, [[maybe_unused]] size_t pass, [[maybe_unused]] size_t fail,
+					   [[maybe_unused]] size_t fatal, [[maybe_unused]] const source_location& location,
+					   [[maybe_unused]] std::chrono::microseconds duration) override
+		{
+			output() << "]\n}";
 		}
 
-		void suite_end(const char* name, size_t pass, size_t fail, size_t fatal, const source_location& location,
-					   std::chrono::microseconds duration) override
+		// the suites that run aren't known up front (e.g. benchmarks, filtered categories), the array closes here
+		void write_totals([[maybe_unused]] size_t pass, [[maybe_unused]] size_t fail, [[maybe_unused]] size_t fatal,
+						  [[maybe_unused]] std::chrono::microseconds duration,
+						  [[maybe_unused]] std::chrono::microseconds user_duration) override
 		{
-			if(m_Iteration == m_Tests)
-				output() << "]\n}]\n";
-			else
-				output() << "]\n},\n";
+			output() << ((m_Iteration == 0u) ? "[]\n" : "]\n");
 		}
 
 	  private:
-		size_t m_Tests{0u};
 		size_t m_Iteration{0u};
+		// within the current suite
+		size_t m_Permutation{0u};
+		size_t m_Measured{0u};
 	};
 } // namespace litmus::formatters
@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <litmus/details/mapped_file.hpp>
+#include <litmus/details/scope.hpp>
+#include <litmus/details/utility.hpp>
+#include <litmus/generator/file.hpp>
+#include <litmus/litmus.hpp>
+
+namespace litmus
+{
+	/*
+		customization point for `generator::corpus<T>`, decodes the bytes of a single input (a corpus file, or the
+		input of the fuzzer). Any amount of bytes should be accepted. A specialization needs to provide:
+			auto operator()(std::span<const std::byte> bytes) const -> T;
+	*/
+	template <typename T>
+	struct bytes_decoder_t;
+
+	// the bytes themselves, they remain valid for as long as the suite runs
+	template <>
+	struct bytes_decoder_t<std::span<const std::byte>>
+	{
+		auto operator()(std::span<const std::byte> bytes) const noexcept -> std::span<const std::byte>
+		{
+			return bytes;
+		}
+	};
+
+	template <>
+	struct bytes_decoder_t<std::string_view>
+	{
+		auto operator()(std::span<const std::byte> bytes) const noexcept -> std::string_view
+		{
+			return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+		}
+	};
+
+	template <>
+	struct bytes_decoder_t<std::string>
+	{
+		auto operator()(std::span<const std::byte> bytes) const -> std::string
+		{
+			return std::string{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+		}
+	};
+
+	template <typename T>
+		requires(sizeof(T) == 1 && std::is_trivially_copyable_v<T>)
+	struct bytes_decoder_t<std::vector<T>>
+	{
+		auto operator()(std::span<const std::byte> bytes) const -> std::vector<T>
+		{
+			std::vector<T> res(bytes.size());
+			if(!bytes.empty()) std::memcpy(res.data(), bytes.data(), bytes.size());
+			return res;
+		}
+	};
+
+	// the leading bytes of the input, zero filled when it's too short
+	template <typename T>
+		requires(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+	struct bytes_decoder_t<T>
+	{
+		auto operator()(std::span<const std::byte> bytes) const noexcept -> T
+		{
+			T res{};
+			if(!bytes.empty()) std::memcpy(&res, bytes.data(), std::min(sizeof(T), bytes.size()));
+			return res;
+		}
+	};
+
+	inline namespace internal
+	{
+		// the regular files of a corpus directory in a stable order, `error` is set when it can't be listed
+		inline auto corpus_files(const std::string& directory, std::error_code& error) -> std::vector<std::string>
+		{
+			std::vector<std::string> res{};
+			std::filesystem::directory_iterator it{directory, error};
+			for(; !error && it != std::filesystem::directory_iterator{}; it.increment(error))
+			{
+				std::error_code type_error{};
+				if(it->is_regular_file(type_error)) res.emplace_back(it->path().string());
+			}
+			std::sort(std::begin(res), std::end(res));
+			return res;
+		}
+	} // namespace internal
+} // namespace litmus
+
+namespace litmus::generator
+{
+	/*
+		streams the files of a corpus directory, every file is memory mapped and decoded as a single value. The
+		corpus is a single permutation of the suite that is invoked once per file, see `records` for how the output
+		is kept small. `--corpus` replaces the directory of every corpus argument, so any corpus (e.g. one a fuzzer
+		grew) can be replayed as a regression test. A directory or file that can't be read is a fatal result.
+
+		When litmus is built as a fuzz target (`LITMUS_FUZZ`) the input of the fuzzer is decoded in place of the
+		files, see `litmus::fuzz`.
+
+		note: the directory is resolved relative to the working directory when the suite runs.
+	*/
+	template <typename T = std::span<const std::byte>, typename Decoder = bytes_decoder_t<T>>
+	class corpus
+	{
+	  public:
+		constexpr static bool is_generator{true};
+
+		struct chunk_t
+		{
+			constexpr static bool is_stream{true};
+			constexpr static bool is_corpus{true};
+			using value_type = T;
+
+			template <typename Fn>
+			auto for_each(Fn&& fn) const -> std::optional<std::string>
+			{
+				if(input)
+				{
+					fn(Decoder{}(*input), 0);
+					return std::nullopt;
+				}
+
+				std::error_code error{};
+				files = corpus_files(resolved(), error);
+				if(error)
+					return combine_text("could not open the corpus directory '", resolved(), "': ", error.message());
+				for(size_t i = 0; i < files.size(); ++i)
+				{
+					mapped_file_t file{files[i], error};
+					if(error) return open_error(files[i], error);
+					file.sequential(0, file.size());
+					fn(Decoder{}(file.bytes()), i);
+				}
+				return std::nullopt;
+			}
+
+			auto describe() const -> std::string
+			{
+				if(input) return combine_text("fuzzer input of ", std::to_string(input->size()), " bytes");
+				return combine_text("corpus ", resolved());
+			}
+			auto describe(size_t index) const -> std::string
+			{
+				if(input) return describe();
+				return (index < files.size()) ? files[index] : describe();
+			}
+
+			auto resolved() const -> const std::string&
+			{
+				return config->corpus.empty() ? *directory : config->corpus;
+			}
+
+			std::shared_ptr<const std::string> directory{};
+			// set by the fuzzer, the only value that is decoded when present
+			std::optional<std::span<const std::byte>> input{};
+			// listed once by `for_each`, in the order the files were decoded in
+			mutable std::vector<std::string> files{};
+		};
+
+		corpus(std::string directory) : m_Directory(std::make_shared<const std::string>(std::move(directory))) {}
+
+		auto size() const noexcept -> size_t { return 1; }
+		auto at([[maybe_unused]] size_t index) const -> chunk_t { return {m_Directory}; }
+		auto next() -> chunk_t { return at(0); }
+
+	  private:
+		std::shared_ptr<const std::string> m_Directory{};
+	};
+} // namespace litmus::generator
@@ -0,0 +1,274 @@
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include <litmus/details/exceptions.hpp>
+#include <litmus/details/mapped_file.hpp>
+#include <litmus/details/scope.hpp>
+#include <litmus/details/utility.hpp>
+
+namespace litmus
+{
+	/*
+		customization point for `generator::records<T>`, decodes a fixed size binary record. A specialization needs
+		to provide:
+			static constexpr size_t size;												// bytes per record
+			auto operator()(std::span<const std::byte, size> bytes) const -> T;
+	*/
+	template <typename T>
+	struct record_decoder_t;
+
+	template <typename T>
+		requires(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>)
+	struct record_decoder_t<T>
+	{
+		static constexpr size_t size = sizeof(T);
+		auto operator()(std::span<const std::byte, size> bytes) const noexcept -> T
+		{
+			T res{};
+			std::memcpy(&res, bytes.data(), size);
+			return res;
+		}
+	};
+
+	/*
+		customization point for `generator::lines<T>`, decodes a single line (without the line ending). A
+		specialization needs to provide:
+			auto operator()(std::string_view line) const -> T;
+	*/
+	template <typename T>
+	struct line_decoder_t;
+
+	template <>
+	struct line_decoder_t<std::string_view>
+	{
+		auto operator()(std::string_view line) const noexcept -> std::string_view { return line; }
+	};
+
+	template <>
+	struct line_decoder_t<std::string>
+	{
+		auto operator()(std::string_view line) const -> std::string { return std::string{line}; }
+	};
+
+	template <typename T>
+		requires(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+	struct line_decoder_t<T>
+	{
+		auto operator()(std::string_view line) const -> T
+		{
+			T res{};
+			const auto begin = line.find_first_not_of(" \t");
+			if(begin != std::string_view::npos) line.remove_prefix(begin);
+			auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), res);
+			except(error != std::errc{},
+				   std::runtime_error(combine_text("could not decode line '", std::string{line}, "'")));
+			return res;
+		}
+	};
+
+	inline namespace internal
+	{
+		inline auto file_size_or_zero(const std::string& filename) noexcept -> size_t
+		{
+			std::error_code error{};
+			const auto size = std::filesystem::file_size(filename, error);
+			return (error) ? 0u : static_cast<size_t>(size);
+		}
+
+		inline auto open_error(const std::string& filename, const std::error_code& error) -> std::string
+		{
+			return combine_text("could not open '", filename, "': ", error.message());
+		}
+	} // namespace internal
+} // namespace litmus
+
+namespace litmus::generator
+{
+	/*
+		streams fixed size binary records out of a memory mapped file. The file is split into chunks of
+		`records_per_chunk` records, every chunk is a single permutation of the suite that decodes its records
+		lazily and invokes the suite once per record. Only the first failing record of a chunk is kept in the
+		output, the others are tallied. A file that can't be read is a fatal result of the chunk.
+
+		note: the filename is resolved relative to the working directory when the suite runs.
+	*/
+	template <typename T, typename Decoder = record_decoder_t<T>>
+	class records
+	{
+		static constexpr size_t record_size = Decoder::size;
+		static_assert(record_size > 0, "records should be at least a byte in size");
+
+	  public:
+		constexpr static bool is_generator{true};
+
+		struct chunk_t
+		{
+			constexpr static bool is_stream{true};
+			using value_type = T;
+
+			template <typename Fn>
+			auto for_each(Fn&& fn) const -> std::optional<std::string>
+			{
+				std::error_code error{};
+				mapped_file_t file{*filename, error};
+				if(error) return open_error(*filename, error);
+				if(file.size() % record_size != 0)
+					return combine_text("the size of '", *filename, "' is not a multiple of the record size");
+				const auto count = std::min(last, file.size() / record_size);
+				if(first >= count) return std::nullopt;
+
+				file.sequential(first * record_size, (count - first) * record_size);
+				for(auto i = first; i < count; ++i)
+				{
+					fn(Decoder{}(std::span<const std::byte, record_size>{file.data() + i * record_size, record_size}),
+					   i);
+				}
+				return std::nullopt;
+			}
+
+			auto describe() const -> std::string
+			{
+				const auto end =
+					(last == std::numeric_limits<size_t>::max()) ? std::string{"end"} : std::to_string(last);
+				return combine_text(*filename, " [records ", std::to_string(first), "..", end, ")");
+			}
+			auto describe(size_t index) const -> std::string
+			{
+				return combine_text(*filename, " [record ", std::to_string(index), "]");
+			}
+
+			std::shared_ptr<const std::string> filename{};
+			size_t first{0};
+			size_t last{0};
+		};
+
+		records(std::string filename, size_t records_per_chunk = size_t{1} << 16u)
+			: m_Filename(std::make_shared<const std::string>(std::move(filename))),
+			  m_PerChunk(std::max<size_t>(records_per_chunk, 1u))
+		{
+			const auto count = file_size_or_zero(*m_Filename) / record_size;
+			m_Chunks		 = std::max<size_t>((count + m_PerChunk - 1) / m_PerChunk, 1u);
+		}
+
+		auto size() const noexcept -> size_t { return m_Chunks; }
+
+		auto at(size_t index) const -> chunk_t
+		{
+			const auto first = index * m_PerChunk;
+			// the last chunk is left open ended in case the file grew since it was registered.
+			return {m_Filename, first,
+					(index + 1 == m_Chunks) ? std::numeric_limits<size_t>::max() : first + m_PerChunk};
+		}
+
+		auto next() -> chunk_t { return at(m_Current++); }
+
+	  private:
+		std::shared_ptr<const std::string> m_Filename{};
+		size_t m_PerChunk{};
+		size_t m_Chunks{1};
+		size_t m_Current{0};
+	};
+
+	/*
+		streams line delimited records out of a memory mapped file, see `records` for the chunking behaviour.
+		The file is split in chunks of roughly `bytes_per_chunk` bytes, a line belongs to the chunk it starts in.
+		Both '\n' and "\r\n" line endings are accepted.
+	*/
+	template <typename T = std::string_view, typename Decoder = line_decoder_t<T>>
+	class lines
+	{
+	  public:
+		constexpr static bool is_generator{true};
+
+		struct chunk_t
+		{
+			constexpr static bool is_stream{true};
+			using value_type = T;
+
+			template <typename Fn>
+			auto for_each(Fn&& fn) const -> std::optional<std::string>
+			{
+				std::error_code error{};
+				mapped_file_t file{*filename, error};
+				if(error) return open_error(*filename, error);
+				const auto* data = reinterpret_cast<const char*>(file.data());
+				const auto size	 = file.size();
+				const auto end	 = std::min(last, size);
+				auto position	 = first;
+				if(position >= end) return std::nullopt;
+
+				// skip the line that started in the previous chunk
+				if(position > 0 && data[position - 1] != '\n')
+				{
+					const auto* newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+					if(newline == nullptr) return std::nullopt;
+					position = static_cast<size_t>(newline - data) + 1;
+				}
+
+				file.sequential(position, end - position);
+				while(position < end)
+				{
+					const auto* newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+					const auto line_end = (newline == nullptr) ? size : static_cast<size_t>(newline - data);
+					std::string_view line{data + position, line_end - position};
+					if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+					fn(Decoder{}(line), position);
+					position = line_end + 1;
+				}
+				return std::nullopt;
+			}
+
+			auto describe() const -> std::string
+			{
+				const auto end =
+					(last == std::numeric_limits<size_t>::max()) ? std::string{"end"} : std::to_string(last);
+				return combine_text(*filename, " [bytes ", std::to_string(first), "..", end, ")");
+			}
+			auto describe(size_t offset) const -> std::string
+			{
+				return combine_text(*filename, " [line at byte ", std::to_string(offset), "]");
+			}
+
+			std::shared_ptr<const std::string> filename{};
+			size_t first{0};
+			size_t last{0};
+		};
+
+		lines(std::string filename, size_t bytes_per_chunk = size_t{1} << 24u)
+			: m_Filename(std::make_shared<const std::string>(std::move(filename))),
+			  m_PerChunk(std::max<size_t>(bytes_per_chunk, 1u))
+		{
+			const auto size = file_size_or_zero(*m_Filename);
+			m_Chunks		= std::max<size_t>((size + m_PerChunk - 1) / m_PerChunk, 1u);
+		}
+
+		auto size() const noexcept -> size_t { return m_Chunks; }
+
+		auto at(size_t index) const -> chunk_t
+		{
+			const auto first = index * m_PerChunk;
+			return {m_Filename, first,
+					(index + 1 == m_Chunks) ? std::numeric_limits<size_t>::max() : first + m_PerChunk};
+		}
+
+		auto next() -> chunk_t { return at(m_Current++); }
+
+	  private:
+		std::shared_ptr<const std::string> m_Filename{};
+		size_t m_PerChunk{};
+		size_t m_Chunks{1};
+		size_t m_Current{0};
+	};
+} // namespace litmus::generator
@@ -0,0 +1,260 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <litmus/details/scope.hpp>
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		/*
+			builds a covering array of the given strength using IPOG: every combination of `strength` values from
+			any `strength` parameters appears in at least one row. The rows store the value index per parameter.
+		*/
+		template <size_t Size>
+		auto build_covering_array(const std::array<size_t, Size>& sizes, size_t strength)
+			-> std::vector<std::array<size_t, Size>>
+		{
+			using row_t				   = std::array<size_t, Size>;
+			constexpr size_t dont_care = std::numeric_limits<size_t>::max();
+			std::vector<row_t> rows{};
+			for(auto size : sizes)
+			{
+				if(size == 0) return rows;
+			}
+
+			strength = std::min(strength, Size);
+			// seed the array with the full cartesian product of the first `strength` parameters.
+			row_t seed{};
+			seed.fill(dont_care);
+			for(size_t i = 0; i < strength; ++i) seed[i] = 0;
+			for(bool done = false; !done;)
+			{
+				rows.emplace_back(seed);
+				done = true;
+				for(size_t i = strength; i-- > 0;)
+				{
+					if(++seed[i] < sizes[i])
+					{
+						done = false;
+						break;
+					}
+					seed[i] = 0;
+				}
+			}
+
+			struct combination_t
+			{
+				std::vector<size_t> parameters{};
+				std::vector<bool> uncovered{};
+				size_t remaining{0};
+				size_t parameter_end{0};
+
+				auto index_of(const row_t& row, const std::array<size_t, Size>& sizes, size_t value) const -> size_t
+				{
+					size_t index{0};
+					for(auto parameter : parameters)
+					{
+						if(row[parameter] == dont_care) return dont_care;
+						index = index * sizes[parameter] + row[parameter];
+					}
+					return index * sizes[parameter_end] + value;
+				}
+			};
+
+			for(size_t parameter = strength; parameter < Size; ++parameter)
+			{
+				// every (strength - 1) sized combination of the previous parameters, paired with this one.
+				std::vector<combination_t> combinations{};
+				std::vector<size_t> indices(strength - 1);
+				for(size_t i = 0; i < indices.size(); ++i) indices[i] = i;
+				while(true)
+				{
+					combination_t combination{indices, {}, 0, parameter};
+					size_t count{sizes[parameter]};
+					for(auto index : indices) count *= sizes[index];
+					combination.uncovered.assign(count, true);
+					combination.remaining = count;
+					combinations.emplace_back(std::move(combination));
+
+					size_t i = indices.size();
+					while(i > 0 && indices[i - 1] == parameter - indices.size() + i - 1) --i;
+					if(i == 0) break;
+					++indices[i - 1];
+					for(size_t j = i; j < indices.size(); ++j) indices[j] = indices[j - 1] + 1;
+				}
+
+				auto cover = [&](const row_t& row, bool apply) -> size_t {
+					size_t covered{0};
+					for(auto& combination : combinations)
+					{
+						const auto index = combination.index_of(row, sizes, row[parameter]);
+						if(index == dont_care || !combination.uncovered[index]) continue;
+						++covered;
+						if(apply)
+						{
+							combination.uncovered[index] = false;
+							combination.remaining -= 1;
+						}
+					}
+					return covered;
+				};
+
+				// horizontal growth, extend every row with the value that covers the most new combinations.
+				for(auto& row : rows)
+				{
+					size_t best_value{0};
+					size_t best_covered{0};
+					for(size_t value = 0; value < sizes[parameter]; ++value)
+					{
+						row[parameter] = value;
+						if(const auto covered = cover(row, false); covered > best_covered)
+						{
+							best_covered = covered;
+							best_value	 = value;
+						}
+					}
+					row[parameter] = best_value;
+					cover(row, true);
+				}
+
+				// vertical growth, add (or fill in) rows for the combinations that are still uncovered.
+				for(auto& combination : combinations)
+				{
+					for(size_t index = 0; combination.remaining > 0 && index < combination.uncovered.size(); ++index)
+					{
+						if(!combination.uncovered[index]) continue;
+
+						row_t values{};
+						values.fill(dont_care);
+						auto remainder	  = index;
+						values[parameter] = remainder % sizes[parameter];
+						remainder		  = remainder / sizes[parameter];
+						for(auto it = combination.parameters.rbegin(); it != combination.parameters.rend(); ++it)
+						{
+							values[*it] = remainder % sizes[*it];
+							remainder	= remainder / sizes[*it];
+						}
+
+						auto compatible = [&values, parameter](const row_t& row) {
+							for(size_t i = 0; i <= parameter; ++i)
+							{
+								if(values[i] != dont_care && row[i] != dont_care && row[i] != values[i]) return false;
+							}
+							return true;
+						};
+
+						auto it = std::find_if(std::begin(rows), std::end(rows), compatible);
+						if(it == std::end(rows))
+						{
+							rows.emplace_back(values);
+							it = std::prev(std::end(rows));
+						}
+						else
+						{
+							for(size_t i = 0; i <= parameter; ++i)
+							{
+								if(values[i] != dont_care) (*it)[i] = values[i];
+							}
+						}
+						cover(*it, true);
+					}
+				}
+			}
+
+			for(auto& row : rows)
+			{
+				for(auto& value : row)
+				{
+					if(value == dont_care) value = 0;
+				}
+			}
+			return rows;
+		}
+	} // namespace internal
+} // namespace litmus
+
+namespace litmus::generator
+{
+	/*
+		combines several generators into a single one that only yields enough permutations to cover every
+		combination of `Strength` values, instead of the full cartesian product. The values are spread over the
+		suite's parameters as if the generators were passed individually.
+	*/
+	template <size_t Strength, typename... Generators>
+	class covering_array
+	{
+		static_assert(Strength > 0, "strength should be at least 1");
+		static_assert((IsGenerator<Generators> && ...), "covering_array only accepts generators");
+
+		template <typename T>
+		using value_t = std::remove_cvref_t<decltype(std::declval<T&>().next())>;
+
+		using values_t = std::tuple<std::vector<value_t<Generators>>...>;
+		using row_t	   = std::array<size_t, sizeof...(Generators)>;
+
+		struct data_t
+		{
+			values_t values{};
+			std::vector<row_t> rows{};
+		};
+
+	  public:
+		constexpr static bool is_generator{true};
+		constexpr static bool is_spread_generator{true};
+
+		covering_array(Generators... generators)
+		{
+			auto data = std::make_shared<data_t>();
+			auto fill = [](auto& values, auto generator) {
+				values.reserve(generator.size());
+				for(size_t i = 0; i < generator.size(); ++i) values.emplace_back(generator.next());
+			};
+			[&]<size_t... N>(std::index_sequence<N...>)
+			{
+				(fill(std::get<N>(data->values), generators), ...);
+				data->rows = build_covering_array(row_t{std::get<N>(data->values).size()...}, Strength);
+			}
+			(std::index_sequence_for<Generators...>{});
+			m_Data = std::move(data);
+		}
+
+		auto size() const noexcept -> size_t { return m_Data->rows.size(); }
+
+		auto at(size_t index) const
+		{
+			const auto& row = m_Data->rows[index];
+			return [&]<size_t... N>(std::index_sequence<N...>)
+			{
+				return std::tuple{std::get<N>(m_Data->values)[row[N]]...};
+			}
+			(std::index_sequence_for<Generators...>{});
+		}
+
+		auto next() { return at(m_Current++); }
+
+	  private:
+		std::shared_ptr<const data_t> m_Data;
+		size_t m_Current{0};
+	};
+
+	template <size_t Strength, typename... Generators>
+	[[nodiscard]] auto n_wise(Generators&&... generators)
+		-> covering_array<Strength, std::remove_cvref_t<Generators>...>
+	{
+		return {std::forward<Generators>(generators)...};
+	}
+
+	template <typename... Generators>
+	[[nodiscard]] auto pairwise(Generators&&... generators) -> covering_array<2, std::remove_cvref_t<Generators>...>
+	{
+		return {std::forward<Generators>(generators)...};
+	}
+} // namespace litmus::generator
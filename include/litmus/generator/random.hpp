@@ -0,0 +1,315 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <litmus/details/random.hpp>
+#include <litmus/details/scope.hpp>
+#include <litmus/details/utility.hpp>
+
+namespace litmus
+{
+	/*
+		customization point for `generator::random<T>`, specialize this for your own types.
+		a specialization needs to provide:
+			auto operator()(prng_t& prng, size_t complexity) const -> T;	// complexity grows from 0 to 100
+			auto shrink(const T& value) const -> std::vector<T>;			// simpler candidates, simplest first
+		and can optionally provide:
+			auto to_string(const T& value) const -> std::string;			// used to print counterexamples
+	*/
+	template <typename T>
+	struct random_value_t;
+
+	inline namespace internal
+	{
+		template <typename T>
+		struct is_basic_string : std::false_type
+		{};
+
+		template <typename CharT, typename Traits, typename Alloc>
+		struct is_basic_string<std::basic_string<CharT, Traits, Alloc>> : std::true_type
+		{};
+
+		template <typename T>
+		concept IsRandomValue = requires(const random_value_t<T>& gen, prng_t& prng, const T& value) {
+									{
+										gen(prng, size_t{})
+										} -> std::convertible_to<T>;
+									{
+										gen.shrink(value)
+										} -> std::convertible_to<std::vector<T>>;
+								};
+
+		template <typename T>
+		concept IsRandomContainer = !is_basic_string<T>::value && IsRandomValue<typename T::value_type> &&
+									requires(T container, typename T::value_type value) {
+										container.clear();
+										container.insert(std::end(container), value);
+									};
+
+		// amount of single element removals a shrink pass will attempt on strings and containers
+		inline constexpr size_t random_shrink_removals{16u};
+
+		template <typename T>
+		auto random_value_to_string(const T& value) -> std::string
+		{
+			if constexpr(requires(const random_value_t<T>& gen) {
+							 {
+								 gen.to_string(value)
+								 } -> std::convertible_to<std::string>;
+						 })
+				return random_value_t<T>{}.to_string(value);
+			else
+				return stringify(value);
+		}
+	} // namespace internal
+
+	template <>
+	struct random_value_t<bool>
+	{
+		auto operator()(prng_t& prng, [[maybe_unused]] size_t complexity) const -> bool { return (prng() & 1u) != 0; }
+		auto shrink(const bool& value) const -> std::vector<bool>
+		{
+			if(value) return {false};
+			return {};
+		}
+		auto to_string(const bool& value) const -> std::string { return (value) ? "true" : "false"; }
+	};
+
+	template <typename T>
+		requires(std::is_integral_v<T> && !std::is_same_v<T, bool>)
+	struct random_value_t<T>
+	{
+		auto operator()(prng_t& prng, size_t complexity) const -> T
+		{
+			using limits = std::numeric_limits<T>;
+			if(prng.chance(10))
+			{
+				constexpr T edges[]{T{0}, T{1}, static_cast<T>(limits::max() - 1), limits::max(), limits::min(),
+									static_cast<T>(limits::min() + 1)};
+				return edges[prng.below(std::size(edges))];
+			}
+
+			// the amount of significant bits grows with the complexity, so early cases stay small.
+			const auto bits = 1u + ((limits::digits - 1u) * std::min<size_t>(complexity, 100u)) / 100u;
+			const auto mask = (bits >= 64u) ? ~std::uint64_t{0} : ((std::uint64_t{1} << bits) - 1u);
+			const auto value = static_cast<T>(prng() & mask);
+			if constexpr(std::is_signed_v<T>)
+			{
+				if((prng() & 1u) != 0) return static_cast<T>(-value);
+			}
+			return value;
+		}
+
+		auto shrink(const T& value) const -> std::vector<T>
+		{
+			if(value == T{0}) return {};
+			std::vector<T> res{T{0}};
+			if constexpr(std::is_signed_v<T>)
+			{
+				if(value < T{0} && value != std::numeric_limits<T>::min()) res.emplace_back(static_cast<T>(-value));
+			}
+			const auto half = static_cast<T>(value / 2);
+			if(half != T{0}) res.emplace_back(half);
+			const auto step = static_cast<T>((value > T{0}) ? value - 1 : value + 1);
+			if(step != T{0} && step != half) res.emplace_back(step);
+			return res;
+		}
+	};
+
+	template <typename T>
+		requires(std::is_floating_point_v<T>)
+	struct random_value_t<T>
+	{
+		auto operator()(prng_t& prng, size_t complexity) const -> T
+		{
+			using limits = std::numeric_limits<T>;
+			if(prng.chance(10))
+			{
+				constexpr T edges[]{T{0},			 -T{0},			  T{1},
+									T{-1},			 limits::min(),	  limits::max(),
+									limits::lowest(), limits::epsilon(), limits::denorm_min()};
+				return edges[prng.below(std::size(edges))];
+			}
+
+			// magnitude grows from [-1, 1] up to [-1e10, 1e10]
+			const auto scale = std::pow(T{10}, static_cast<T>(std::min<size_t>(complexity, 100u)) / T{10});
+			return static_cast<T>((prng.unit() * 2.0 - 1.0) * scale);
+		}
+
+		auto shrink(const T& value) const -> std::vector<T>
+		{
+			if(value == T{0} || std::isnan(value)) return {};
+			std::vector<T> res{T{0}};
+			if(value < T{0}) res.emplace_back(-value);
+			if(std::isfinite(value) && std::trunc(value) != value) res.emplace_back(std::trunc(value));
+			if(std::abs(value) > T{1}) res.emplace_back(value / T{2});
+			return res;
+		}
+	};
+
+	template <typename CharT, typename Traits, typename Alloc>
+	struct random_value_t<std::basic_string<CharT, Traits, Alloc>>
+	{
+		using type = std::basic_string<CharT, Traits, Alloc>;
+
+		auto operator()(prng_t& prng, size_t complexity) const -> type
+		{
+			type res{};
+			res.resize(prng.below(std::min<size_t>(complexity, 100u) + 1u));
+			for(auto& ch : res)
+			{
+				// mostly printable ascii, with the occasional control character mixed in
+				if(prng.chance(20))
+				{
+					constexpr CharT specials[]{CharT{0}, CharT{'\t'}, CharT{'\n'}, CharT{'\r'}, CharT{127}};
+					ch = specials[prng.below(std::size(specials))];
+				}
+				else
+					ch = static_cast<CharT>(' ' + prng.below('~' - ' ' + 1));
+			}
+			return res;
+		}
+
+		auto shrink(const type& value) const -> std::vector<type>
+		{
+			if(value.empty()) return {};
+			std::vector<type> res{type{}};
+			if(value.size() > 1)
+			{
+				res.emplace_back(value.substr(0, value.size() / 2));
+				res.emplace_back(value.substr(value.size() / 2));
+			}
+			for(size_t i = 0; i < std::min(value.size(), random_shrink_removals); ++i)
+			{
+				res.emplace_back(value).erase(i, 1);
+			}
+			if(auto it = std::find_if(std::begin(value), std::end(value), [](CharT ch) { return ch != CharT{'a'}; });
+			   it != std::end(value))
+			{
+				res.emplace_back(value)[std::distance(std::begin(value), it)] = CharT{'a'};
+			}
+			return res;
+		}
+
+		auto to_string(const type& value) const -> std::string
+		{
+			std::string res{"\""};
+			res.reserve(value.size() + 2);
+			for(auto ch : value)
+			{
+				if(ch >= CharT{' '} && ch <= CharT{'~'})
+					res += static_cast<char>(ch);
+				else
+					res += "\\x" + std::to_string(static_cast<std::uint32_t>(ch));
+			}
+			res += '"';
+			return res;
+		}
+	};
+
+	template <IsRandomContainer T>
+	struct random_value_t<T>
+	{
+		using value_type = typename T::value_type;
+
+		auto operator()(prng_t& prng, size_t complexity) const -> T
+		{
+			T res{};
+			const auto count = prng.below(std::min<size_t>(complexity, 100u) / 2u + 1u);
+			for(size_t i = 0; i < count; ++i) res.insert(std::end(res), random_value_t<value_type>{}(prng, complexity));
+			return res;
+		}
+
+		auto shrink(const T& value) const -> std::vector<T>
+		{
+			const auto size = static_cast<size_t>(std::distance(std::begin(value), std::end(value)));
+			if(size == 0) return {};
+
+			auto copy_without = [&value](size_t begin, size_t end) {
+				T res{};
+				size_t index{0};
+				for(const auto& element : value)
+				{
+					if(index < begin || index >= end) res.insert(std::end(res), element);
+					++index;
+				}
+				return res;
+			};
+
+			std::vector<T> res{T{}};
+			if(size > 1)
+			{
+				res.emplace_back(copy_without(size / 2, size));
+				res.emplace_back(copy_without(0, size / 2));
+			}
+			for(size_t i = 0; i < std::min(size, random_shrink_removals); ++i) res.emplace_back(copy_without(i, i + 1));
+
+			// finally try simplifying the elements themselves, one candidate per element.
+			size_t index{0};
+			for(const auto& element : value)
+			{
+				if(index++ == random_shrink_removals) break;
+				auto candidates = random_value_t<value_type>{}.shrink(element);
+				if(candidates.empty()) continue;
+				T simplified{};
+				size_t target{0};
+				for(const auto& other : value)
+				{
+					simplified.insert(std::end(simplified), (target++ == index - 1) ? candidates.front() : other);
+				}
+				res.emplace_back(std::move(simplified));
+			}
+			return res;
+		}
+
+		auto to_string(const T& value) const -> std::string
+		{
+			std::vector<std::string> elements{};
+			for(const auto& element : value) elements.emplace_back(random_value_to_string(element));
+			return "{" + join(elements, ", ") + "}";
+		}
+	};
+} // namespace litmus
+
+namespace litmus::generator
+{
+	/*
+		property based generator, the suite is invoked `Cases` times with values drawn from a seeded prng. Unlike
+		the `range` and `array` generators the values are drawn when the suite runs, so only a single test is
+		registered regardless of the amount of cases. When a case fails the values are shrunk to a minimal
+		counterexample, which is reported together with the seed (rerun with `--seed` to reproduce).
+
+		note: as `random` collides with the POSIX `random()` function, refer to it as `generator::random`.
+	*/
+	template <typename T, size_t Cases = 100, typename Generator = random_value_t<T>>
+	class random
+	{
+	  public:
+		constexpr static bool is_property_generator{true};
+		using value_type = T;
+
+		constexpr auto size() const noexcept -> size_t { return Cases; }
+
+		auto draw(prng_t& prng, size_t complexity) const -> T { return Generator{}(prng, complexity); }
+
+		auto shrink(const T& value) const -> std::vector<T> { return Generator{}.shrink(value); }
+
+		auto to_string(const T& value) const -> std::string
+		{
+			if constexpr(requires(const Generator& gen) {
+							 {
+								 gen.to_string(value)
+								 } -> std::convertible_to<std::string>;
+						 })
+				return Generator{}.to_string(value);
+			else
+				return random_value_to_string(value);
+		}
+	};
+} // namespace litmus::generator
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 namespace litmus::generator
 {
@@ -10,6 +11,13 @@ namespace litmus::generator
 			return lhs + rhs;
 		}
 
+		// value after `count` increments, lets the range be indexed without stepping through it
+		template <typename T>
+		static constexpr auto advance(const T& lhs, const T& rhs, size_t count) noexcept
+		{
+			return static_cast<T>(lhs + rhs * static_cast<T>(count));
+		}
+
 		template <typename T>
 		static constexpr auto validate(const T& lhs, const T& rhs, const T& steps) noexcept
 		{
@@ -23,10 +31,46 @@ namespace litmus::generator
 		}
 	};
 
+	// geometric progression, `range<size_t, 1 << 10, 1 << 20, 2, range_multiply>` doubles every step
+	struct range_multiply
+	{
+		template <typename T>
+		static constexpr auto next(const T& lhs, const T& rhs) noexcept
+		{
+			return lhs * rhs;
+		}
+
+		template <typename T>
+		static constexpr auto advance(const T& lhs, const T& rhs, size_t count) noexcept
+		{
+			auto value{lhs};
+			for(size_t i = 0; i < count; ++i) value = static_cast<T>(value * rhs);
+			return value;
+		}
+
+		template <typename T>
+		static constexpr auto validate(const T& lhs, const T& rhs, const T& factor) noexcept
+		{
+			if(lhs <= T{0} || factor <= T{1} || rhs < lhs) return false;
+			auto value{lhs};
+			while(value < rhs) value = static_cast<T>(value * factor);
+			return value == rhs;
+		}
+
+		template <typename T>
+		static constexpr auto size(const T& lhs, const T& rhs, const T& factor) noexcept
+		{
+			T count{1};
+			for(auto value{lhs}; value < rhs; value = static_cast<T>(value * factor)) ++count;
+			return count;
+		}
+	};
+
 	template <typename T, T Min, T Max, T Increment = T{1}, typename Operation = range_plus>
 	class range
 	{
-		static_assert(Operation::validate(Min, Max, Increment), "Increment should be a multiple of [Max - Min]");
+		static_assert(Operation::validate(Min, Max, Increment),
+					  "Max should be reachable from Min in steps of Increment (or by multiplying by it)");
 
 	  public:
 		constexpr static bool is_generator{true};
@@ -35,6 +79,20 @@ namespace litmus::generator
 
 		constexpr auto size() const noexcept { return Operation::size(Min, Max, Increment); }
 
+		constexpr auto at(size_t index) const noexcept
+		{
+			if constexpr(requires { Operation::advance(Min, Increment, index); })
+			{
+				return Operation::advance(Min, Increment, index);
+			}
+			else
+			{
+				auto value{Min};
+				for(size_t i = 0; i < index; ++i) value = Operation::next(value, Increment);
+				return value;
+			}
+		}
+
 		constexpr auto next() noexcept
 		{
 			auto curr = m_Current;
@@ -58,6 +116,8 @@ namespace litmus::generator
 
 		constexpr auto size() const noexcept { return sizeof...(Values) + 1; }
 
+		constexpr auto at(size_t index) const noexcept { return m_Values[index]; }
+
 		constexpr auto next() noexcept
 		{
 			m_Current += 1;
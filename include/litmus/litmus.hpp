@@ -1,6 +1,9 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -17,6 +20,19 @@ namespace litmus
 
 	inline namespace internal
 	{
+		enum class benchmark_mode_t
+		{
+			skip,
+			after, // after the tests
+			only,  // instead of the tests
+		};
+
+		enum class list_format_t
+		{
+			compact,
+			json,
+		};
+
 		struct config_t
 		{
 
@@ -27,10 +43,30 @@ namespace litmus
 				size_t source_size_limit{80u};
 				std::vector<std::string> categories{};
 				verbosity_t verbosity{verbosity_t::NORMAL};
-				bool rerun_failed{false};
+				// retries of a failing permutation
+				size_t rerun_failed{0u};
+				size_t repeat{1u};
+				bool until_fail{false};
 				bool single_threaded{false};
+				bool fork_sections{false};
+				size_t workers{0u};
+				// a permutation that runs longer in a worker is killed, and reported as fatal
+				std::optional<std::chrono::milliseconds> worker_timeout{};
 				bool break_on_fatal{false};
 				bool break_on_fail{false};
+				size_t aggregate{0u};
+				std::uint64_t seed{0u};
+				benchmark_mode_t benchmarks{benchmark_mode_t::skip};
+				std::optional<size_t> pin_cpu{};
+				std::string histograms{};
+				std::optional<list_format_t> list{};
+				std::string durations{};
+				std::optional<std::chrono::milliseconds> progress{};
+				// replaces the directory of every `generator::corpus`
+				std::string corpus{};
+				// set by `litmus::fuzz`, passing expects are only counted
+				bool fuzzing{false};
+				bool update_snapshots{false};
 			} data{};
 
 			config_t()				  = default;
@@ -55,6 +91,12 @@ namespace litmus
 
 	// NOLINTNEXTLINE
 	auto run(int argc, char* argv[], formatter* formatter = nullptr) noexcept -> int;
+
+	/*
+		libFuzzer entry point, runs every suite with a `generator::corpus` argument with `data` decoded in its place.
+		A failing suite is written to stderr and aborts, which the fuzzer reports as a crash.
+	*/
+	auto fuzz(const std::uint8_t* data, size_t size) noexcept -> int;
 } // namespace litmus
 
 
@@ -62,6 +104,13 @@ namespace litmus
 #include <litmus/suite.hpp>
 #include <litmus/section.hpp>
 #include <litmus/expect.hpp>
+#include <litmus/approx.hpp>
+#include <litmus/expect_range.hpp>
+#include <litmus/snapshot.hpp>
+#include <litmus/fixture.hpp>
+#include <litmus/task.hpp>
+#include <litmus/thread.hpp>
+#include <litmus/explore.hpp>
 #endif
 
 #define LITMUS_EXTERN()                                                                                                \
@@ -69,9 +118,15 @@ namespace litmus
 	litmus::internal::cache_t litmus::internal::cache{};                                                               \
 	litmus::internal::config_t litmus::internal::config {}
 
+#if defined(LITMUS_FUZZ)
+#define LITMUS_MAIN()                                                                                                  \
+	LITMUS_EXTERN();                                                                                                   \
+	extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, size_t size) { return litmus::fuzz(data, size); }
+#else
 #define LITMUS_MAIN()                                                                                                  \
 	LITMUS_EXTERN();                                                                                                   \
 	int main(int argc, char* argv[]) { return litmus::run(argc, argv); }
+#endif
 
 #if defined(LITMUS_FULL)
 LITMUS_MAIN()
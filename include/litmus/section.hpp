@@ -3,8 +3,10 @@
 #include <stdexcept>
 #include <tuple>
 #include <litmus/details/fixed_string.hpp>
+#include <litmus/details/fork.hpp>
 #include <litmus/details/scope.hpp>
 #include <litmus/details/test_result.hpp>
+#include <litmus/task.hpp>
 
 #include "strtype/strtype.hpp"
 
@@ -37,6 +39,7 @@ namespace litmus
 					return false;
 				}
 
+				if(fork::active()) return fork::section();
 				return (suite_context.stack.empty() || suite_context.stack.get(m_Depth) == m_Index);
 			}
 
@@ -64,10 +67,17 @@ namespace litmus
 												std::vector<std::string>{stringify(values)...});
 				try
 				{
-					if constexpr(sizeof...(InvokeTypes) > 0)
-						fn.template operator()<InvokeTypes...>(std::forward<Ts>(values)...);
+					auto body = [&]() -> decltype(auto) {
+						if constexpr(sizeof...(InvokeTypes) > 0)
+							return fn.template operator()<InvokeTypes...>(std::forward<Ts>(values)...);
+						else
+							return fn(std::forward<Ts>(values)...);
+					};
+					// coroutine sections complete before the section returns, their suite waits on them
+					if constexpr(IsTask<std::remove_cvref_t<decltype(body())>>)
+						run_inline(body());
 					else
-						fn(std::forward<Ts>(values)...);
+						body();
 				}
 				catch(const std::exception& e)
 				{
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <litmus/expect.hpp>
+
+#ifndef LITMUS_SNAPSHOT_DIRECTORY
+#define LITMUS_SNAPSHOT_DIRECTORY "snapshots"
+#endif
+
+namespace litmus
+{
+	inline namespace internal
+	{
+		template <typename T>
+		concept IsSnapshotBuffer =
+			std::ranges::contiguous_range<T> && std::ranges::sized_range<T> &&
+			sizeof(std::ranges::range_value_t<T>) == 1 && std::is_trivially_copyable_v<std::ranges::range_value_t<T>>;
+
+		// 64 bit hash of the contents of a snapshot, the XXH64 algorithm (with a seed of 0)
+		[[nodiscard]] auto snapshot_hash(std::span<const std::byte> bytes) noexcept -> std::uint64_t;
+
+		struct snapshot_outcome_t
+		{
+			bool pass;
+			std::string lhs;
+			std::string rhs;
+			std::string info;
+		};
+
+		/*
+			compares `bytes` against the snapshot `name`, which lives in `LITMUS_SNAPSHOT_DIRECTORY` next to the
+			source file of the suite (of the call site when there's no suite), prefixed with '--source'. A `.hash`
+			file next to the snapshot holds the hash of its contents, when the snapshot wasn't touched since it was
+			written only `bytes` are hashed. Otherwise, or when the hashes differ, the snapshot is memory mapped and
+			compared directly, a mismatch reports the first differing line and writes `bytes` to a `.actual` file
+			next to the snapshot, a match removes it again. '--update-snapshots' (atomically) rewrites the snapshot
+			and its hash instead, and writes the hash of a snapshot that matches, ordinary runs never touch either.
+		*/
+		[[nodiscard]] auto compare_snapshot(std::span<const std::byte> bytes, std::string_view name,
+											const source_location& location) -> snapshot_outcome_t;
+
+		template <bool Fatal>
+		auto log_snapshot(std::span<const std::byte> bytes, std::string_view name, const source_location& location)
+			-> bool
+		{
+			if(suite_context.output.fatal) return false;
+			auto outcome = compare_snapshot(bytes, name, location);
+			trigger_break(outcome.pass, Fatal);
+			if(tallied(outcome.pass) || aggregated<Fatal>(outcome.pass, location)) return outcome.pass;
+			if(!expect_info.message.empty()) outcome.info = combine_text(expect_info.message, " ", outcome.info);
+			record_expect(outcome.lhs, outcome.rhs, {}, {}, test_result_t::expect_t::operation_t::equal, outcome.pass,
+						  Fatal, outcome.info);
+			expect_info.message = {};
+
+			suite_context.output.fatal = !outcome.pass && Fatal;
+			return outcome.pass;
+		}
+
+		template <typename T>
+		[[nodiscard]] auto snapshot_bytes(const T& buffer) noexcept -> std::span<const std::byte>
+		{
+			return {reinterpret_cast<const std::byte*>(std::ranges::data(buffer)), std::ranges::size(buffer)};
+		}
+	} // namespace internal
+
+	// expects `buffer` (a contiguous range of bytes or characters) to match the snapshot `name`, see `compare_snapshot`
+	template <typename T>
+		requires(IsSnapshotBuffer<T>)
+	[[maybe_unused]] auto expect_snapshot(const T& buffer, std::string_view name,
+										  const source_location& location = source_location::current()) -> bool
+	{
+		return log_snapshot<false>(snapshot_bytes(buffer), name, location);
+	}
+
+	template <typename T>
+		requires(IsSnapshotBuffer<T>)
+	[[maybe_unused]] auto require_snapshot(const T& buffer, std::string_view name,
+										   const source_location& location = source_location::current()) -> bool
+	{
+		return log_snapshot<true>(snapshot_bytes(buffer), name, location);
+	}
+} // namespace litmus
@@ -1,10 +1,21 @@
 #pragma once
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <type_traits>
 
 #include <litmus/details/fixed_string.hpp>
+#include <litmus/details/fork.hpp>
+#include <litmus/details/random.hpp>
 #include <litmus/details/runner.hpp>
 #include <litmus/details/scope.hpp>
 #include <litmus/details/source_location.hpp>
+#include <litmus/fixture.hpp>
+#include <litmus/task.hpp>
+
+#ifndef LITMUS_MAX_SHRINKS
+#define LITMUS_MAX_SHRINKS 1024
+#endif
 
 namespace litmus
 {
@@ -16,57 +27,492 @@ namespace litmus
 
 	inline namespace internal
 	{
+		// the type the suite receives for a captured argument
+		template <typename T>
+		struct argument_value
+		{
+			using type = T;
+		};
+
+		template <typename T>
+			requires(IsPropertyGenerator<T> || IsStream<T>)
+		struct argument_value<T>
+		{
+			using type = typename T::value_type;
+		};
+
+		template <typename T>
+		using argument_value_t = typename argument_value<T>::type;
+
+		template <typename T>
+		struct argument_traits;
+
+		template <typename... Ts>
+		struct argument_traits<std::tuple<Ts...>>
+		{
+			static constexpr bool has_property = (IsPropertyGenerator<Ts> || ...);
+			static constexpr bool has_stream   = (IsStream<Ts> || ...);
+			static constexpr bool has_fixture  = (IsFixture<Ts> || ...);
+			static constexpr bool has_corpus   = (IsCorpus<Ts> || ...);
+		};
+
+		// the arguments the suite body is invoked with
+		template <typename T>
+		struct invoked_values;
+
+		template <typename... Ts>
+		struct invoked_values<std::tuple<Ts...>>
+		{
+			using type = decltype(resolve_fixtures(std::declval<const std::tuple<argument_value_t<Ts>...>&>()));
+		};
+
+		// true when no categories were requested, or the suite has one of them
+		[[nodiscard]] inline auto categories_selected(const std::vector<const char*>& categories) -> bool
+		{
+			return config->categories.empty() ||
+				   std::any_of(std::begin(categories), std::end(categories), [](const auto& category) {
+					   return std::find(std::begin(config->categories), std::end(config->categories), category) !=
+							  std::end(config->categories);
+				   });
+		}
+
 		struct suite_functor
 		{
 			static constexpr bool supports_generators = true;
 			static constexpr bool supports_templates  = true;
+			static constexpr bool supports_explore	  = true;
 
 			bool should_run() noexcept { return true; }
 
-			template <typename... InvokeTypes, typename... Ts>
-			constexpr void operator()(auto& fn, const char* name, const source_location& location,
-									  const std::vector<const char*>& categories, Ts&&... values)
+			// returns the result of the suite body, which is a `task` for coroutines
+			template <typename... InvokeTypes>
+			static auto call(auto& fn, const auto& values) -> decltype(auto)
 			{
-				runner.template test<InvokeTypes...>(name, [name = name, values = std::tuple{values...}, fn = fn,
-															location = location, categories = categories]() {
-					suite_context = {};
+				if constexpr(sizeof...(InvokeTypes) > 0)
+				{
+					return std::apply(
+						[&fn](const auto&... values) -> decltype(auto) {
+							return fn.template operator()<InvokeTypes...>(fixture_value(values)...);
+						},
+						values);
+				}
+				else
+				{
+					return std::apply(
+						[&fn](const auto&... values) -> decltype(auto) { return fn(fixture_value(values)...); },
+						values);
+				}
+			}
 
-					if(config->categories.empty() ||
-					   std::any_of(std::begin(categories), std::end(categories), [](const auto& category) {
-						   return std::find(std::begin(config->categories), std::end(config->categories), category) !=
-								  std::end(config->categories);
-					   }))
-					{
-						static constexpr auto parameter_size = sizeof...(InvokeTypes);
+			// runs the suite once for every unique section permutation
+			template <typename... InvokeTypes>
+			static void invoke(auto& fn, const auto& values)
+			{
+				if(config->fork_sections && !fork::active())
+				{
+					auto paths = fork::run([&fn, &values]() {
+						suite_context.reset();
+						call<InvokeTypes...>(fn, values);
+					});
+					for(const auto& path : paths) suite_context.output.append_path(path);
+					return;
+				}
+
+				invoke_sections<InvokeTypes...>(fn, values);
+			}
+
+			// replays the suite body until every section it contains has run
+			template <typename... InvokeTypes>
+			static void invoke_sections(auto& fn, const auto& values)
+			{
+				test_id_t next_stack{};
+				do
+				{
+					suite_context.reset();
+					suite_context.stack = std::move(next_stack);
+					call<InvokeTypes...>(fn, values);
+					next_stack = std::move(suite_context.stack);
+				} while(!next_stack.empty() && !suite_context.output.fatal);
+			}
+
+			// coroutine counterpart of `invoke`, the event loop swaps in the suite context of the root when resuming
+			template <typename... InvokeTypes>
+			static auto invoke_async(auto& fn, const auto& values) -> task<>
+			{
+				test_id_t next_stack{};
+				do
+				{
+					suite_context.reset();
+					suite_context.stack = std::move(next_stack);
+					co_await call<InvokeTypes...>(fn, values);
+					next_stack = std::move(suite_context.stack);
+				} while(!next_stack.empty() && !suite_context.output.fatal);
+			}
+
+			template <typename... Ts>
+			static auto describe_property(const std::tuple<Ts...>& generators, const auto& values)
+				-> std::vector<std::string>
+			{
+				return [&]<size_t... N>(std::index_sequence<N...>) {
+					return std::vector<std::string>{[&]() -> std::string {
+						if constexpr(IsPropertyGenerator<Ts>)
+							return std::get<N>(generators).to_string(std::get<N>(values));
+						else
+							return stringify(std::get<N>(values));
+					}()...};
+				}(std::index_sequence_for<Ts...>{});
+			}
 
-						suite_context.output.scope_open(name, {}, location,
-														pack_to_string<std::tuple_size_v<decltype(values)>>(values));
-						test_id_t next_stack{};
-						do
+			// tries the shrink candidates of every property argument, returns true when a simpler failing case
+			// was found (which is then stored in `current`).
+			template <size_t Index = 0, typename... Ts>
+			static auto shrink_property(const std::tuple<Ts...>& generators, auto& current, auto& run_case,
+										size_t& attempts) -> bool
+			{
+				if constexpr(Index == sizeof...(Ts))
+				{
+					return false;
+				}
+				else
+				{
+					if constexpr(IsPropertyGenerator<std::tuple_element_t<Index, std::tuple<Ts...>>>)
+					{
+						for(auto& candidate : std::get<Index>(generators).shrink(std::get<Index>(current)))
 						{
-							suite_context.reset();
-							suite_context.stack = std::move(next_stack);
-							if constexpr(parameter_size > 0)
+							if(attempts++ >= LITMUS_MAX_SHRINKS) return false;
+							auto trial				= current;
+							std::get<Index>(trial) = std::move(candidate);
+							if(!run_case(trial))
 							{
-								std::apply(
-									[&fn](auto&&... values) { fn.template operator()<InvokeTypes...>(values...); },
-									values);
+								current = std::move(trial);
+								return true;
 							}
+						}
+					}
+					return shrink_property<Index + 1>(generators, current, run_case, attempts);
+				}
+			}
+
+			/*
+				runs all cases of the property generators in a single test, stops at the first failing case and
+				shrinks it. On success only an aggregate record is kept, on failure the record of the shrunk
+				counterexample is kept.
+			*/
+			template <typename... InvokeTypes, typename... Ts>
+			static void invoke_property(auto& fn, const char* name, const source_location& location,
+										const std::tuple<Ts...>& generators)
+			{
+				using values_t = std::tuple<argument_value_t<Ts>...>;
+
+				const size_t cases = std::max({size_t{1}, [&generators]<size_t... N>(std::index_sequence<N...>) {
+												  return std::max({size_t{0}, [&]() -> size_t {
+																	   if constexpr(IsPropertyGenerator<Ts>)
+																		   return std::get<N>(generators).size();
+																	   else
+																		   return 0u;
+																   }()...});
+											  }(std::index_sequence_for<Ts...>{})});
+
+				prng_t prng{config->seed ^ hash_string(name)};
+				auto draw = [&prng, &generators](size_t complexity) {
+					return [&]<size_t... N>(std::index_sequence<N...>) {
+						return values_t{[&]() -> argument_value_t<Ts> {
+							if constexpr(IsPropertyGenerator<Ts>)
+								return std::get<N>(generators).draw(prng, complexity);
 							else
-							{
-								std::apply(fn, values);
-							}
+								return std::get<N>(generators);
+						}()...};
+					}(std::index_sequence_for<Ts...>{});
+				};
 
-							next_stack = std::move(suite_context.stack);
-						} while(!next_stack.empty() && !suite_context.output.fatal);
+				auto run_case = [&fn, name, &location](const values_t& values) -> bool {
+					suite_context = {};
+					suite_context.output.scope_open(name, {}, location);
+					invoke<InvokeTypes...>(fn, values);
+					suite_context.output.scope_close();
+					suite_context.output.sync();
+					return !suite_context.output.fails && !suite_context.output.fatal;
+				};
 
-						suite_context.output.scope_close();
+				test_result_t report{};
+				report.scope_open(name, {}, location);
+				size_t pass{0};
+				for(size_t i = 0; i < cases; ++i)
+				{
+					auto values = draw(((i + 1) * 100u) / cases);
+					if(run_case(values))
+					{
+						pass += suite_context.output.root().pass;
+						continue;
 					}
+
+					size_t attempts{0};
+					size_t shrinks{0};
+					while(shrink_property(generators, values, run_case, attempts)) ++shrinks;
+
+					// replay the minimal counterexample, this time with its values described.
+					run_case(values);
+					auto& root		= std::get<test_result_t::scope_t>(suite_context.output.results[0]);
+					root.parameters = describe_property(generators, values);
+					root.parameters.emplace_back(combine_text("case ", std::to_string(i + 1), "/",
+															  std::to_string(cases), ", shrunk ",
+															  std::to_string(shrinks), " times, --seed ",
+															  std::to_string(config->seed)));
+					return;
+				}
+
+				auto& root		= std::get<test_result_t::scope_t>(report.results[0]);
+				root.parameters = std::vector<std::string>{
+					combine_text(std::to_string(cases), " cases, --seed ", std::to_string(config->seed))};
+				report.scope_results(0, pass, 0, 0);
+				report.scope_close();
+				suite_context.output = std::move(report);
+			}
+
+			/*
+				invokes the suite for every value of the stream argument within a single test. Passing values are
+				only tallied, the record of the first failing value is kept (with its totals replaced by those of
+				the entire stream), so the output does not grow with the size of the stream.
+			*/
+			template <typename... InvokeTypes, typename... Ts>
+			static void invoke_stream(auto& fn, const char* name, const source_location& location,
+									  const std::tuple<Ts...>& values)
+			{
+				static_assert((IsStream<Ts> + ...) == 1, "only a single stream argument per suite is supported");
+				static_assert((!IsPropertyGenerator<Ts> && ...),
+							  "stream arguments cannot be combined with property generators");
+				using values_t = std::tuple<argument_value_t<Ts>...>;
+
+				constexpr auto stream_index = []<size_t... N>(std::index_sequence<N...>) {
+					return ((IsStream<Ts> ? N : 0u) + ...);
+				}(std::index_sequence_for<Ts...>{});
+				const auto& stream = std::get<stream_index>(values);
+
+				size_t pass{0};
+				size_t fail{0};
+				size_t fatal{0};
+				size_t count{0};
+				size_t failed{0};
+				std::optional<test_result_t> failure{};
+				std::vector<std::string> parameters{};
+
+				auto report_start = timing::now();
+				const auto error  = stream.for_each([&](auto&& value, size_t index) {
+					auto arguments = [&]<size_t... N>(std::index_sequence<N...>) {
+						return values_t{[&]() -> argument_value_t<Ts> {
+							if constexpr(N == stream_index)
+								return std::forward<decltype(value)>(value);
+							else
+								return std::get<N>(values);
+						}()...};
+					}(std::index_sequence_for<Ts...>{});
+
+					suite_context = {};
+					suite_context.output.scope_open(name, {}, location);
+					invoke<InvokeTypes...>(fn, arguments);
+					suite_context.output.scope_close();
 					suite_context.output.sync();
-					return suite_context.output;
+
+					const auto& root = suite_context.output.root();
+					pass += root.pass;
+					fail += root.fail;
+					fatal += root.fatal;
+					++count;
+					if(!suite_context.output.fails && !suite_context.output.fatal) return;
+
+					++failed;
+					if(failure) return;
+					parameters = pack_to_string<sizeof...(Ts)>(arguments);
+					parameters[stream_index] = stream.describe(index);
+					failure					 = std::move(suite_context.output);
 				});
+
+				if(error)
+				{
+					// the values that were read are still counted, the stream itself is the fatal result
+					suite_context = {};
+					suite_context.output.scope_open(name, {}, location);
+					suite_context.output.expect_result(stream.describe(), "readable", {}, {},
+													   test_result_t::expect_t::operation_t::equal, false, true,
+													   *error);
+					suite_context.output.scope_close();
+					suite_context.output.fatal = true;
+					parameters				   = pack_to_string<sizeof...(Ts)>(values);
+					parameters[stream_index]   = stream.describe();
+					fatal += 1;
+				}
+				else if(failure)
+				{
+					suite_context.output = std::move(*failure);
+					parameters.emplace_back(combine_text(std::to_string(failed), " of ", std::to_string(count),
+														 " values failed"));
+				}
+				else
+				{
+					suite_context = {};
+					suite_context.output.scope_open(name, {}, location);
+					suite_context.output.scope_close();
+					parameters				 = pack_to_string<sizeof...(Ts)>(values);
+					parameters[stream_index] = combine_text(stream.describe(), ", ", std::to_string(count), " values");
+				}
+
+				auto& root		= std::get<test_result_t::scope_t>(suite_context.output.results[0]);
+				root.parameters	= std::move(parameters);
+				root.pass		= pass;
+				root.fail		= fail;
+				root.fatal		= fatal;
+				root.start		= report_start;
+				root.end		= timing::now();
+			}
+
+			template <typename... InvokeTypes, typename... Ts>
+			void operator()(auto& fn, const char* name, const source_location& location,
+							const std::vector<const char*>& categories, const std::tuple<Ts...>& args);
+		};
+
+		template <typename Fn, typename Args, typename... InvokeTypes>
+		class suite_permutations_t final : public permutations_t
+		{
+		  public:
+			suite_permutations_t(Fn fn, Args args, const char* name, const source_location& location,
+								 std::vector<const char*> categories)
+				: m_Fn(std::move(fn)), m_Args(std::move(args)), m_Name(name), m_Location(location),
+				  m_Categories(std::move(categories)), m_Size(permutation_count(m_Args))
+			{}
+
+			[[nodiscard]] auto size() const noexcept -> size_t override { return m_Size; }
+
+			[[nodiscard]] auto run(size_t index) const -> test_result_t override
+			{
+				if constexpr(is_coroutine)
+				{
+					test_result_t result{};
+					event_loop_t loop{};
+					start(index, loop, result);
+					loop.run();
+					return result;
+				}
+				else
+				{
+					suite_context = {};
+					if(!categories_selected(m_Categories)) return suite_context.output;
+
+					if constexpr(traits_t::has_fixture)
+						execute(resolve_fixtures(permutation_at(m_Args, index)));
+					else
+						execute(permutation_at(m_Args, index));
+					return suite_context.output;
+				}
+			}
+
+			[[nodiscard]] auto is_async() const noexcept -> bool override { return is_coroutine; }
+
+			void start(size_t index, event_loop_t& loop, test_result_t& result) const override
+			{
+				if constexpr(is_coroutine)
+					spawn(loop, run_async(index, result));
+				else
+					result = run(index);
+			}
+
+			[[nodiscard]] auto fuzzable() const noexcept -> bool override { return traits_t::has_corpus; }
+
+			void fuzz(size_t index, std::span<const std::byte> input, test_result_t& result) const override
+			{
+				if constexpr(traits_t::has_corpus)
+				{
+					auto values = permutation_at(m_Args, index);
+					std::apply(
+						[input](auto&... value) {
+							(
+								[input](auto& value) {
+									if constexpr(IsCorpus<std::remove_cvref_t<decltype(value)>>) value.input = input;
+								}(value),
+								...);
+						},
+						values);
+
+					suite_context = {};
+					if constexpr(traits_t::has_fixture)
+						execute(resolve_fixtures(values));
+					else
+						execute(values);
+					result = std::move(suite_context.output);
+				}
 			}
+
+			[[nodiscard]] auto describe(size_t index) const -> std::vector<std::string> override
+			{
+				const auto values = permutation_at(m_Args, index);
+				return pack_to_string<std::tuple_size_v<std::remove_cvref_t<decltype(values)>>>(values);
+			}
+
+			[[nodiscard]] auto location() const noexcept -> const source_location& override { return m_Location; }
+			[[nodiscard]] auto categories() const noexcept -> std::span<const char* const> override
+			{
+				return m_Categories;
+			}
+
+		  private:
+			using values_t = decltype(permutation_at(std::declval<const Args&>(), 0));
+			using traits_t = argument_traits<values_t>;
+			using result_t = decltype(suite_functor::call<InvokeTypes...>(
+				std::declval<const Fn&>(), std::declval<const typename invoked_values<values_t>::type&>()));
+			static constexpr bool is_coroutine = IsTask<std::remove_cvref_t<result_t>>;
+			static_assert(!is_coroutine || (!traits_t::has_property && !traits_t::has_stream),
+						  "coroutine suites do not support property generators or stream arguments");
+
+
+			// sections are always replayed, '--fork-sections' does not apply to coroutine suites
+			auto run_async(size_t index, test_result_t& result) const -> task<>
+			{
+				if(!categories_selected(m_Categories)) co_return;
+				const auto values = resolve_fixtures(permutation_at(m_Args, index));
+				suite_context.output.scope_open(m_Name, {}, m_Location);
+				co_await suite_functor::invoke_async<InvokeTypes...>(m_Fn, values);
+				suite_context.output.scope_close();
+				suite_context.output.sync();
+				result = std::move(suite_context.output);
+			}
+
+			template <typename... Ts>
+			void execute(const std::tuple<Ts...>& values) const
+			{
+				using traits_t = argument_traits<std::tuple<Ts...>>;
+				if constexpr(traits_t::has_property)
+				{
+					suite_functor::invoke_property<InvokeTypes...>(m_Fn, m_Name, m_Location, values);
+				}
+				else if constexpr(traits_t::has_stream)
+				{
+					suite_functor::invoke_stream<InvokeTypes...>(m_Fn, m_Name, m_Location, values);
+				}
+				else
+				{
+					suite_context.output.scope_open(m_Name, {}, m_Location);
+					suite_functor::invoke<InvokeTypes...>(m_Fn, values);
+					suite_context.output.scope_close();
+					suite_context.output.sync();
+				}
+			}
+
+			Fn m_Fn;
+			Args m_Args;
+			const char* m_Name;
+			source_location m_Location;
+			std::vector<const char*> m_Categories;
+			size_t m_Size;
 		};
+
+		template <typename... InvokeTypes, typename... Ts>
+		void suite_functor::operator()(auto& fn, const char* name, const source_location& location,
+									   const std::vector<const char*>& categories, const std::tuple<Ts...>& args)
+		{
+			using args_t		 = std::tuple<std::remove_cvref_t<Ts>...>;
+			using permutations = suite_permutations_t<std::remove_cvref_t<decltype(fn)>, args_t, InvokeTypes...>;
+			runner.template test<InvokeTypes...>(
+				name, std::make_unique<const permutations>(fn, args_t{args}, name, location, categories));
+		}
 	} // namespace internal
 	template <fixed_string Name, fixed_string... Categories>
 	[[nodiscard]] constexpr auto suite(const source_location& location = source_location::current())
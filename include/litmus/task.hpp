@@ -0,0 +1,231 @@
+#pragma once
+#include <chrono>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <litmus/details/event_loop.hpp>
+#include <litmus/details/exceptions.hpp>
+
+namespace litmus
+{
+	template <typename T = void>
+	class task;
+
+	inline namespace internal
+	{
+		struct task_promise_base_t
+		{
+			struct final_awaiter_t
+			{
+				[[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+				// continues with the awaiting coroutine, a root instead reports its completion to the loop
+				template <typename Promise>
+				auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<>
+				{
+					auto& promise = handle.promise();
+					if(promise.continuation) return promise.continuation;
+					if(promise.root != nullptr)
+					{
+						promise.root->exception = promise.exception;
+						promise.root->done		= true;
+					}
+					return std::noop_coroutine();
+				}
+
+				void await_resume() const noexcept {}
+			};
+
+			auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+			auto final_suspend() noexcept -> final_awaiter_t { return {}; }
+			void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+			std::coroutine_handle<> continuation{};
+			event_loop_t::root_t* root{nullptr};
+			std::exception_ptr exception{};
+		};
+
+		template <typename T>
+		struct task_promise_t : task_promise_base_t
+		{
+			auto get_return_object() noexcept -> task<T>;
+
+			template <typename Y>
+			void return_value(Y&& value)
+			{
+				result.emplace(std::forward<Y>(value));
+			}
+
+			std::optional<T> result{};
+		};
+
+		template <>
+		struct task_promise_t<void> : task_promise_base_t
+		{
+			auto get_return_object() noexcept -> task<void>;
+			void return_void() noexcept {}
+		};
+
+		template <typename T>
+		concept IsTaskPromise = std::is_base_of_v<task_promise_base_t, T>;
+
+		// suspends the awaiting task until the running event loop resumes it
+		template <typename Fn>
+		struct loop_awaiter_t
+		{
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+			template <IsTaskPromise Promise>
+			auto await_suspend(std::coroutine_handle<Promise> handle) -> bool
+			{
+				auto* loop = event_loop_t::current();
+				if(except(loop == nullptr, std::runtime_error("litmus awaitables require a running event loop")))
+					return false;
+				schedule(*loop, handle, handle.promise().root);
+				return true;
+			}
+
+			void await_resume() const noexcept {}
+
+			Fn schedule;
+		};
+
+		template <typename Fn>
+		loop_awaiter_t(Fn) -> loop_awaiter_t<Fn>;
+	} // namespace internal
+
+	/*
+		coroutine type of asynchronous suite and section bodies, and of the helpers they await. Tasks start when
+		they are awaited, suites returning a task are driven by the event loop of the runner thread.
+	*/
+	template <typename T>
+	class task
+	{
+	  public:
+		using promise_type = task_promise_t<T>;
+
+		struct awaiter_t
+		{
+			[[nodiscard]] auto await_ready() const noexcept -> bool { return !handle || handle.done(); }
+
+			// the awaited task runs within the root (and so the suite context) of the awaiting one
+			template <IsTaskPromise Promise>
+			auto await_suspend(std::coroutine_handle<Promise> awaiting) noexcept -> std::coroutine_handle<>
+			{
+				handle.promise().continuation = awaiting;
+				handle.promise().root		  = awaiting.promise().root;
+				return handle;
+			}
+
+			auto await_resume() -> T
+			{
+				if(handle.promise().exception) std::rethrow_exception(handle.promise().exception);
+				if constexpr(!std::is_void_v<T>) return std::move(*handle.promise().result);
+			}
+
+			std::coroutine_handle<promise_type> handle;
+		};
+
+		explicit task(std::coroutine_handle<promise_type> handle) noexcept : m_Handle(handle) {}
+		task(const task&) = delete;
+		task(task&& other) noexcept : m_Handle(std::exchange(other.m_Handle, {})) {}
+		~task()
+		{
+			if(m_Handle) m_Handle.destroy();
+		}
+
+		auto operator=(const task&) -> task& = delete;
+		auto operator=(task&& other) noexcept -> task&
+		{
+			if(this != &other)
+			{
+				if(m_Handle) m_Handle.destroy();
+				m_Handle = std::exchange(other.m_Handle, {});
+			}
+			return *this;
+		}
+
+		auto operator co_await() noexcept -> awaiter_t { return awaiter_t{m_Handle}; }
+
+		// hands the ownership of the coroutine to the caller
+		[[nodiscard]] auto release() noexcept -> std::coroutine_handle<promise_type>
+		{
+			return std::exchange(m_Handle, {});
+		}
+
+	  private:
+		std::coroutine_handle<promise_type> m_Handle{};
+	};
+
+	inline namespace internal
+	{
+		template <typename T>
+		auto task_promise_t<T>::get_return_object() noexcept -> task<T>
+		{
+			return task<T>{std::coroutine_handle<task_promise_t<T>>::from_promise(*this)};
+		}
+
+		inline auto task_promise_t<void>::get_return_object() noexcept -> task<void>
+		{
+			return task<void>{std::coroutine_handle<task_promise_t<void>>::from_promise(*this)};
+		}
+
+		template <typename T>
+		concept IsTask = requires { typename T::promise_type; } && IsTaskPromise<typename T::promise_type>;
+
+		// starts `body` on `loop` as a root, with its own suite context
+		inline void spawn(event_loop_t& loop, task<> body)
+		{
+			auto handle			  = body.release();
+			handle.promise().root = &loop.spawn(handle);
+		}
+
+		/*
+			runs `body` to completion within the current suite context, e.g. the coroutine body of a section. Other
+			suites on the loop wait until it completes.
+		*/
+		inline void run_inline(task<> body)
+		{
+			event_loop_t local{};
+			auto* loop = (event_loop_t::current() != nullptr) ? event_loop_t::current() : &local;
+
+			auto handle = body.release();
+			event_loop_t::root_t root{handle, true};
+			handle.promise().root = &root;
+			loop->run_until(root);
+			handle.destroy();
+			if(root.exception) std::rethrow_exception(root.exception);
+		}
+	} // namespace internal
+
+	// resumes the awaiting task once `duration` has passed, other tasks run in the meantime
+	template <typename Rep, typename Period>
+	[[nodiscard]] auto sleep_for(std::chrono::duration<Rep, Period> duration)
+	{
+		const auto deadline =
+			event_loop_t::clock::now() + std::chrono::duration_cast<event_loop_t::clock::duration>(duration);
+		return loop_awaiter_t{[deadline](event_loop_t& loop, std::coroutine_handle<> handle, auto* root) {
+			loop.resume_at(deadline, handle, root);
+		}};
+	}
+
+	// resumes the awaiting task once `fd` has data to read
+	[[nodiscard]] inline auto readable(int fd)
+	{
+		return loop_awaiter_t{[fd](event_loop_t& loop, std::coroutine_handle<> handle, auto* root) {
+			loop.resume_when(fd, false, handle, root);
+		}};
+	}
+
+	// resumes the awaiting task once `fd` can be written to
+	[[nodiscard]] inline auto writable(int fd)
+	{
+		return loop_awaiter_t{[fd](event_loop_t& loop, std::coroutine_handle<> handle, auto* root) {
+			loop.resume_when(fd, true, handle, root);
+		}};
+	}
+} // namespace litmus
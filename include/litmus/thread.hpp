@@ -0,0 +1,109 @@
+#pragma once
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <litmus/details/context.hpp>
+#include <litmus/details/exceptions.hpp>
+
+namespace litmus
+{
+	/*
+		the suite (and active scope) expects of another thread are recorded in. The results are merged into the
+		suite when that scope closes, so the thread has to be done expecting by then.
+	*/
+	class context_handle
+	{
+	  public:
+		context_handle() = default;
+		context_handle(std::shared_ptr<mpsc_queue_t<test_result_t::expect_t>> queue, size_t scope) noexcept
+			: m_Target{std::move(queue), scope}
+		{}
+
+		[[nodiscard]] auto valid() const noexcept -> bool { return m_Target.queue != nullptr; }
+		[[nodiscard]] auto target() const noexcept -> const remote_target_t& { return m_Target; }
+
+	  private:
+		remote_target_t m_Target{};
+	};
+
+	// captures the active scope of the calling thread, threads that are attached themselves pass their target on
+	[[nodiscard]] inline auto capture_context() -> context_handle
+	{
+		if(remote_target.queue) return context_handle{remote_target.queue, remote_target.scope};
+		if(except(suite_context.output.active_scope_index.empty(),
+				  std::runtime_error("litmus::capture_context can only be called from within a suite")))
+			return {};
+		return context_handle{suite_context.output.remote_queue(), suite_context.output.active_scope_index.top()};
+	}
+
+	// records the expects of the calling thread in the captured context for as long as it lives
+	class attach_context
+	{
+	  public:
+		explicit attach_context(const context_handle& context)
+			: m_Previous(std::exchange(remote_target, context.target())),
+			  m_Fatal(std::exchange(suite_context.output.fatal, false))
+		{}
+		~attach_context()
+		{
+			remote_target			   = std::move(m_Previous);
+			suite_context.output.fatal = m_Fatal;
+		}
+		attach_context(const attach_context&) = delete;
+		attach_context(attach_context&&)	  = delete;
+
+		auto operator=(const attach_context&) -> attach_context& = delete;
+		auto operator=(attach_context&&) -> attach_context&		 = delete;
+
+	  private:
+		remote_target_t m_Previous;
+		bool m_Fatal;
+	};
+
+	/*
+		`std::thread` that records its expects in the suite that started it, and joins when it goes out of scope.
+		A failing `require` skips the remaining expects of the thread, the suite is marked fatal once they merge.
+	*/
+	class thread
+	{
+	  public:
+		thread() noexcept = default;
+
+		template <typename Fn, typename... Args>
+			requires(!std::is_same_v<std::remove_cvref_t<Fn>, thread>)
+		explicit thread(Fn&& fn, Args&&... args)
+			: m_Thread(
+				  [context = capture_context()](auto&& fn, auto&&... args) {
+					  attach_context attached{context};
+					  std::invoke(std::forward<decltype(fn)>(fn), std::forward<decltype(args)>(args)...);
+				  },
+				  std::forward<Fn>(fn), std::forward<Args>(args)...)
+		{}
+
+		thread(thread&&) noexcept = default;
+		auto operator=(thread&& other) noexcept -> thread&
+		{
+			if(this != &other)
+			{
+				if(m_Thread.joinable()) m_Thread.join();
+				m_Thread = std::move(other.m_Thread);
+			}
+			return *this;
+		}
+		~thread()
+		{
+			if(m_Thread.joinable()) m_Thread.join();
+		}
+
+		void join() { m_Thread.join(); }
+		[[nodiscard]] auto joinable() const noexcept -> bool { return m_Thread.joinable(); }
+		[[nodiscard]] auto get_id() const noexcept -> std::thread::id { return m_Thread.get_id(); }
+
+	  private:
+		std::thread m_Thread{};
+	};
+} // namespace litmus
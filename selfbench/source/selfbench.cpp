@@ -0,0 +1,241 @@
+/*
+	microbenchmarks of litmus's own hot paths: expects, section replay, suite registration and the formatters. The
+	results are written as json (to stdout, or to the file given as the first argument) so they can be compared
+	between versions of the framework.
+*/
+#include <litmus/litmus.hpp>
+#include <litmus/expect.hpp>
+#include <litmus/section.hpp>
+#include <litmus/suite.hpp>
+#include <litmus/formatter/detailed.hpp>
+#include <litmus/formatter/json.hpp>
+#include <litmus/formatter/compact.hpp>
+#include <litmus/generator/range.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+LITMUS_EXTERN();
+
+using namespace litmus;
+using namespace litmus::generator;
+
+namespace
+{
+	constexpr size_t batches{9};
+
+	struct result_t
+	{
+		std::string name;
+		std::vector<std::pair<std::string, std::string>> parameters;
+		size_t operations;
+		double median;
+		double min;
+		double max;
+	};
+
+	std::vector<result_t> results{};
+
+	/*
+		times `batches` batches of `operations` invocations of `fn`, `setup` runs untimed before every batch. The
+		median, fastest and slowest batch are recorded in nanoseconds per invocation.
+	*/
+	template <typename Setup, typename Fn>
+	void measure(std::string name, std::vector<std::pair<std::string, std::string>> parameters, size_t operations,
+				 Setup&& setup, Fn&& fn)
+	{
+		using clock = std::chrono::steady_clock;
+		std::vector<double> samples{};
+		setup();
+		fn();
+		for(size_t batch = 0; batch < batches; ++batch)
+		{
+			setup();
+			const auto start = clock::now();
+			for(size_t i = 0; i < operations; ++i) fn();
+			const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+			samples.emplace_back(elapsed / static_cast<double>(operations));
+		}
+		std::sort(std::begin(samples), std::end(samples));
+		results.emplace_back(result_t{std::move(name), std::move(parameters), operations, samples[batches / 2],
+									  samples.front(), samples.back()});
+	}
+
+	// a fresh suite scope on this thread, as the runner would open before invoking a suite
+	void open_suite()
+	{
+		suite_context = {};
+		suite_context.output.scope_open("selfbench", {}, source_location::current());
+	}
+
+	void expects(bool source)
+	{
+		config->no_source = !source;
+		const auto parameters = std::vector<std::pair<std::string, std::string>>{{"source", source ? "yes" : "no"}};
+		int value{42};
+		measure("expect.pass", parameters, 10000, open_suite, [&value] { expect(value) == 42; });
+		measure("expect.fail", parameters, 10000, open_suite, [&value] { expect(value) == 43; });
+		measure("require.pass", parameters, 10000, open_suite, [&value] { require(value) < 43; });
+		measure("evaluate", parameters, 10000, open_suite, [] {
+			std::string lhs{};
+			std::string rhs{};
+			evaluate(source_location::current(), test_result_t::expect_t::operation_t::equal, "expect", lhs, rhs);
+		});
+		suite_context	  = {};
+		config->no_source = true;
+	}
+
+	void stringification()
+	{
+		const std::string text{"a string that does not fit the small string buffer"};
+		auto nothing = [] {};
+		measure("to_string_fn", {{"type", "int"}}, 10000, nothing, [] { (void)to_string_fn(42); });
+		measure("to_string_fn", {{"type", "unsigned"}}, 10000, nothing, [] { (void)to_string_fn(42u); });
+		measure("to_string_fn", {{"type", "double"}}, 10000, nothing, [] { (void)to_string_fn(4.2); });
+		measure("to_string_fn", {{"type", "std::string"}}, 10000, nothing, [&text] { (void)to_string_fn(text); });
+	}
+
+	// `breadth` sibling sections on every level, the suite is replayed once per leaf
+	void nest(size_t depth, size_t breadth)
+	{
+		if(depth == 0)
+		{
+			expect(depth) == 0u;
+			return;
+		}
+		for(size_t i = 0; i < breadth; ++i) section<"level">() = [depth, breadth] { nest(depth - 1, breadth); };
+	}
+
+	auto replay_suite = suite<"selfbench.replay">(range<size_t, 1, 6>{}, range<size_t, 1, 4>{}) =
+		[](size_t depth, size_t breadth) { nest(depth, breadth); };
+
+	void replay()
+	{
+		const auto it = std::find_if(std::begin(runner), std::end(runner), [](const auto& test) {
+			return std::string_view{test.first} == "selfbench.replay";
+		});
+		const auto& permutations = *std::begin(it->second)->second.permutations.front();
+		for(size_t i = 0; i < permutations.size(); ++i)
+		{
+			const auto parameters = permutations.describe(i);
+			const auto scopes	  = permutations.run(i).results.size();
+			const auto operations = std::max<size_t>(10000 / scopes, 1);
+			measure("section.replay", {{"depth", parameters[0]}, {"breadth", parameters[1]}}, operations, [] {},
+					[&permutations, i] { (void)permutations.run(i); });
+		}
+	}
+
+	void registration()
+	{
+		measure("suite.registration", {}, 10000, [] {}, [] { (void)(suite<"selfbench.registration">() = [] {}); });
+		measure("suite.registration", {{"generator", "range<int, 0, 99>"}}, 10000, [] {},
+				[] { (void)(suite<"selfbench.registration">(range<int, 0, 99>{}) = [](int) {}); });
+	}
+
+	// a suite of 1000 expects of which every tenth failed, formatted as a single permutation
+	template <typename Formatter>
+	void format(std::string name)
+	{
+		open_suite();
+		for(size_t i = 0; i < 1000; ++i)
+			suite_context.output.expect_result(std::to_string(i), std::to_string(i % 10 == 0 ? i + 1 : i), "value",
+											   "expected", test_result_t::expect_t::operation_t::equal, i % 10 != 0,
+											   false, {});
+		suite_context.output.scope_close();
+		suite_context.output.sync();
+		const auto output = std::move(suite_context.output);
+		suite_context	  = {};
+
+		const auto& root = std::get<test_result_t::scope_t>(output.results[0]);
+		std::ostringstream stream{};
+		Formatter instance{};
+		litmus::formatter& formatter = instance;
+		measure("formatter", {{"formatter", std::move(name)}, {"expects", "1000"}}, 10, [&stream] { stream.str({}); },
+				[&] {
+					formatter.set_stream(stream, false);
+					formatter.begin(1);
+					formatter.suite_begin("selfbench", root.pass, root.fail, root.fatal, root.location,
+										  std::chrono::microseconds{0});
+					formatter.suite_iterate({}, root.parameters);
+					output.to_string(&formatter);
+					formatter.suite_end("selfbench", root.pass, root.fail, root.fatal, root.location,
+										std::chrono::microseconds{0});
+					formatter.end();
+				});
+	}
+
+	void append_json(std::string& output, const std::string& value)
+	{
+		output += '"';
+		for(auto ch : value)
+		{
+			if(ch == '"' || ch == '\\') output += '\\';
+			output += ch;
+		}
+		output += '"';
+	}
+
+	auto to_json() -> std::string
+	{
+		std::string output{"{\n\t\"litmus_selfbench\": 1,\n\t\"unit\": \"nanoseconds per operation\",\n"};
+		output += "\t\"results\": [";
+		for(size_t r = 0; r < results.size(); ++r)
+		{
+			const auto& result = results[r];
+			output += (r == 0) ? "\n\t\t{\"name\": " : ",\n\t\t{\"name\": ";
+			append_json(output, result.name);
+			output += ", \"parameters\": {";
+			for(size_t p = 0; p < result.parameters.size(); ++p)
+			{
+				if(p > 0) output += ", ";
+				append_json(output, result.parameters[p].first);
+				output += ": ";
+				append_json(output, result.parameters[p].second);
+			}
+			output += "}, \"operations\": " + std::to_string(result.operations);
+			output += ", \"median\": " + std::to_string(result.median);
+			output += ", \"min\": " + std::to_string(result.min);
+			output += ", \"max\": " + std::to_string(result.max) + "}";
+		}
+		output += "\n\t]\n}\n";
+		return output;
+	}
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+	config->no_source = true;
+
+	expects(false);
+	expects(true);
+	stringification();
+	replay();
+	registration();
+	format<formatters::compact>("compact");
+	format<formatters::detailed_stream_formatter_no_color>("detailed");
+	format<formatters::detailed_stream_formatter>("detailed_color");
+	format<formatters::json>("json");
+
+	if(argc < 2)
+	{
+		std::cout << to_json();
+		return 0;
+	}
+	std::ofstream stream(argv[1], std::ios::trunc);
+	if(!stream.is_open())
+	{
+		std::cerr << "could not write the results to " << argv[1] << std::endl;
+		return 1;
+	}
+	stream << to_json();
+	return 0;
+}
@@ -0,0 +1,76 @@
+#include <litmus/details/durations.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <litmus/details/exceptions.hpp>
+
+using namespace litmus::internal;
+
+namespace
+{
+	constexpr std::string_view header{"litmus-durations 1"};
+}
+
+duration_history_t::duration_history_t(const std::string& filename)
+{
+	std::ifstream stream(filename);
+	if(!stream.is_open()) return;
+
+	// "<microseconds>\t<key>" per line
+	std::string line{};
+	if(!std::getline(stream, line) || line != header) return;
+	while(std::getline(stream, line))
+	{
+		std::int64_t microseconds{0};
+		const auto result = std::from_chars(line.data(), line.data() + line.size(), microseconds);
+		if(result.ec != std::errc{} || result.ptr == line.data() + line.size() || *result.ptr != '\t') continue;
+		m_Durations.insert_or_assign(line.substr(static_cast<size_t>(result.ptr + 1 - line.data())),
+									 std::chrono::microseconds{microseconds});
+	}
+}
+
+void duration_history_t::save(const std::string& filename) const
+{
+	// sorted, so the file diffs cleanly between runs
+	std::vector<const std::pair<const std::string, std::chrono::microseconds>*> entries{};
+	entries.reserve(m_Durations.size());
+	for(const auto& entry : m_Durations) entries.emplace_back(&entry);
+	std::sort(std::begin(entries), std::end(entries),
+			  [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+	std::ofstream stream(filename, std::ios::trunc);
+	if(except(!stream.is_open(), std::runtime_error("could not write the durations to " + filename))) return;
+	stream << header << '\n';
+	for(const auto* entry : entries) stream << entry->second.count() << '\t' << entry->first << '\n';
+}
+
+void duration_history_t::record(std::string key, std::chrono::microseconds duration)
+{
+	m_Durations.insert_or_assign(std::move(key), duration);
+}
+
+auto duration_history_t::find(const std::string& key) const -> std::optional<std::chrono::microseconds>
+{
+	if(auto it = m_Durations.find(key); it != std::end(m_Durations)) return it->second;
+	return std::nullopt;
+}
+
+auto duration_history_t::key(std::string_view suite, const std::vector<std::string>& templates, size_t ordinal)
+	-> std::string
+{
+	std::string res{suite};
+	res += '\t';
+	for(size_t i = 0; i < templates.size(); ++i)
+	{
+		if(i > 0) res += ", ";
+		res += templates[i];
+	}
+	res += '\t';
+	res += std::to_string(ordinal);
+	return res;
+}
@@ -0,0 +1,238 @@
+#include <litmus/details/event_loop.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include <litmus/details/exceptions.hpp>
+
+#if defined(__linux__)
+#define LITMUS_EPOLL_SUPPORTED
+#include <cerrno>
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+using namespace litmus::internal;
+
+namespace
+{
+	thread_local event_loop_t* current_loop{nullptr};
+
+	// marks a loop as running on this thread, restores the outer loop when it returns
+	struct current_loop_t
+	{
+		current_loop_t(event_loop_t* loop) noexcept : previous(std::exchange(current_loop, loop)) {}
+		~current_loop_t() { current_loop = previous; }
+		current_loop_t(const current_loop_t&) = delete;
+		auto operator=(const current_loop_t&) -> current_loop_t& = delete;
+
+		event_loop_t* previous;
+	};
+
+#ifdef LITMUS_EPOLL_SUPPORTED
+	// (re)arms the one shot watch of `fd` for the union of the events its waiters are waiting on
+	template <typename T>
+	auto watch(int poll, int operation, int fd, const std::vector<T>& watchers) noexcept -> bool
+	{
+		epoll_event event{};
+		event.events  = EPOLLONESHOT;
+		event.data.fd = fd;
+		for(const auto& watcher : watchers) event.events |= (watcher.write) ? EPOLLOUT : EPOLLIN;
+		return ::epoll_ctl(poll, operation, fd, &event) == 0;
+	}
+#endif
+} // namespace
+
+event_loop_t::~event_loop_t()
+{
+	for(auto& [ptr, root] : m_Roots)
+	{
+		if(root->handle) root->handle.destroy();
+	}
+#ifdef LITMUS_EPOLL_SUPPORTED
+	if(m_Poll >= 0) ::close(m_Poll);
+#endif
+}
+
+auto event_loop_t::current() noexcept -> event_loop_t* { return current_loop; }
+
+auto event_loop_t::spawn(std::coroutine_handle<> handle) -> root_t&
+{
+	auto root	 = std::make_unique<root_t>();
+	root->handle = handle;
+	auto& res	 = *m_Roots.emplace(root.get(), std::move(root)).first->second;
+	m_Ready.push_back({handle, &res});
+	return res;
+}
+
+void event_loop_t::run()
+{
+	current_loop_t running{this};
+	while(!m_Roots.empty())
+	{
+		const auto progress = step(nullptr);
+
+		// completed roots are released, the first exception a suite did not handle ends the run
+		auto finished = std::move(m_Finished);
+		m_Finished	  = {};
+		for(auto* ptr : finished)
+		{
+			auto it	  = m_Roots.find(ptr);
+			auto root = std::move(it->second);
+			m_Roots.erase(it);
+			root->handle.destroy();
+			root->handle = {};
+			if(root->exception) std::rethrow_exception(root->exception);
+		}
+
+		if(!progress && !m_Roots.empty())
+		{
+			except(std::runtime_error("a coroutine suite is suspended without waiting on a timer or file descriptor"));
+			return;
+		}
+	}
+}
+
+void event_loop_t::run_until(root_t& root)
+{
+	current_loop_t running{this};
+	m_Ready.push_back({root.handle, &root});
+	while(!root.done)
+	{
+		if(!step(&root))
+		{
+			except(
+				std::runtime_error("a coroutine section is suspended without waiting on a timer or file descriptor"));
+			return;
+		}
+	}
+}
+
+void event_loop_t::resume_at(clock::time_point deadline, std::coroutine_handle<> handle, root_t* root)
+{
+	m_Timers.emplace(deadline, waiter_t{handle, root});
+}
+
+void event_loop_t::resume_when(int fd, bool write, std::coroutine_handle<> handle, root_t* root)
+{
+#ifdef LITMUS_EPOLL_SUPPORTED
+	if(m_Poll < 0) m_Poll = ::epoll_create1(EPOLL_CLOEXEC);
+	if(except(m_Poll < 0, std::runtime_error("could not create the epoll instance of the event loop")))
+	{
+		m_Ready.push_back({handle, root});
+		return;
+	}
+
+	// the first waiter adds the file descriptor, later ones widen the events it's watched for
+	auto& watchers = m_Watchers[fd];
+	watchers.push_back({{handle, root}, write});
+	if(!watch(m_Poll, (watchers.size() == 1) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, watchers))
+	{
+		const auto error = errno;
+		watchers.pop_back();
+		if(watchers.empty()) m_Watchers.erase(fd);
+		// regular files cannot be polled, they are always ready
+		if(error != EPERM) except(std::runtime_error("could not wait on file descriptor " + std::to_string(fd)));
+		m_Ready.push_back({handle, root});
+		return;
+	}
+#else
+	std::ignore = fd;
+	std::ignore = write;
+	except(std::runtime_error("waiting on file descriptors requires epoll, which is not available on this platform"));
+	m_Ready.push_back({handle, root});
+#endif
+}
+
+auto event_loop_t::step(root_t* only) -> bool
+{
+	// coroutines that become ready while resuming these are resumed in the next step
+	std::deque<waiter_t> ready{};
+	if(only == nullptr)
+		ready.swap(m_Ready);
+	else
+	{
+		std::deque<waiter_t> others{};
+		for(const auto& waiter : m_Ready) ((waiter.root == only) ? ready : others).push_back(waiter);
+		m_Ready.swap(others);
+	}
+
+	if(!ready.empty())
+	{
+		for(const auto& waiter : ready) resume(waiter);
+		return true;
+	}
+
+	if(m_Timers.empty() && m_Watchers.empty()) return false;
+	wait((m_Timers.empty()) ? clock::time_point::max() : std::begin(m_Timers)->first);
+	return true;
+}
+
+void event_loop_t::resume(const waiter_t& waiter)
+{
+	if(waiter.root == nullptr || waiter.root->borrowed)
+	{
+		waiter.handle.resume();
+		return;
+	}
+
+	std::swap(suite_context, waiter.root->context);
+	waiter.handle.resume();
+	std::swap(suite_context, waiter.root->context);
+	if(waiter.root->done) m_Finished.emplace_back(waiter.root);
+}
+
+void event_loop_t::wait(clock::time_point until)
+{
+	bool polled{false};
+#ifdef LITMUS_EPOLL_SUPPORTED
+	if(!m_Watchers.empty())
+	{
+		polled = true;
+		int timeout{-1};
+		if(until != clock::time_point::max())
+		{
+			const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(until - clock::now()).count();
+			timeout				 = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+		}
+
+		epoll_event events[64]{};
+		const auto count = ::epoll_wait(m_Poll, events, 64, timeout);
+		for(int i = 0; i < count; ++i)
+		{
+			auto it = m_Watchers.find(events[i].data.fd);
+			if(it == std::end(m_Watchers)) continue;
+
+			// errors and hang ups wake every waiter, their reads or writes will report it
+			const auto ready = events[i].events;
+			const auto all	 = (ready & (EPOLLERR | EPOLLHUP)) != 0;
+			auto& watchers	 = it->second;
+			std::erase_if(watchers, [&](const watcher_t& watcher) {
+				if(!all && (ready & ((watcher.write) ? EPOLLOUT : EPOLLIN)) == 0) return false;
+				m_Ready.push_back(watcher.waiter);
+				return true;
+			});
+
+			// the watch was one shot, the waiters that are left need it armed again
+			if(watchers.empty() || !watch(m_Poll, EPOLL_CTL_MOD, it->first, watchers))
+			{
+				::epoll_ctl(m_Poll, EPOLL_CTL_DEL, it->first, nullptr);
+				for(const auto& watcher : watchers) m_Ready.push_back(watcher.waiter);
+				m_Watchers.erase(it);
+			}
+		}
+	}
+#endif
+	if(!polled && until != clock::time_point::max()) std::this_thread::sleep_until(until);
+
+	const auto now = clock::now();
+	while(!m_Timers.empty() && std::begin(m_Timers)->first <= now)
+	{
+		m_Ready.push_back(std::begin(m_Timers)->second);
+		m_Timers.erase(std::begin(m_Timers));
+	}
+}
@@ -0,0 +1,204 @@
+#include <litmus/details/explorer.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <litmus/details/exceptions.hpp>
+
+using namespace litmus;
+using namespace litmus::internal;
+
+namespace
+{
+	constexpr size_t no_thread{static_cast<size_t>(-1)};
+
+	thread_local explorer_t* current_explorer{nullptr};
+	thread_local size_t current_index{0};
+
+	// marks the calling thread as scheduled by `explorer`, restores the previous state when it goes out of scope
+	struct scheduled_t
+	{
+		scheduled_t(explorer_t* explorer, size_t index) noexcept
+			: previous(std::exchange(current_explorer, explorer)), previous_index(std::exchange(current_index, index))
+		{}
+		~scheduled_t()
+		{
+			current_explorer = previous;
+			current_index	 = previous_index;
+		}
+		scheduled_t(const scheduled_t&) = delete;
+		auto operator=(const scheduled_t&) -> scheduled_t& = delete;
+
+		explorer_t* previous;
+		size_t previous_index;
+	};
+} // namespace
+
+explorer_t::explorer_t(explore_strategy_t strategy, std::uint64_t seed, std::vector<size_t> prefix)
+	: m_Strategy(strategy), m_Prng(seed), m_Prefix(std::move(prefix))
+{}
+
+auto explorer_t::current() noexcept -> explorer_t* { return current_explorer; }
+
+void explorer_t::run(const std::function<void()>& body)
+{
+	scheduled_t scheduled{this, 0};
+	{
+		std::lock_guard lock{m_Lock};
+		m_Threads.emplace_back();
+		m_Running = 0;
+	}
+
+	// threads that are still running when the body ends (or throws) are joined through the scheduler
+	auto join_all = [this]() {
+		for(size_t i = 1; i < m_Threads.size(); ++i) join(i);
+	};
+	try
+	{
+		body();
+	}
+	catch(...)
+	{
+		join_all();
+		throw;
+	}
+	join_all();
+}
+
+auto explorer_t::spawn(std::function<void()> fn) -> size_t
+{
+	size_t index{};
+	{
+		std::lock_guard lock{m_Lock};
+		index = m_Threads.size();
+		m_Threads.emplace_back();
+		m_Threads.back().handle = std::thread([this, index, fn = std::move(fn)]() {
+			scheduled_t scheduled{this, index};
+			{
+				std::unique_lock lock{m_Lock};
+				m_Turn.wait(lock, [this, index]() { return m_Running == index; });
+			}
+			fn();
+			finish(index);
+		});
+	}
+
+	// the new thread may run before the spawning thread continues
+	yield();
+	return index;
+}
+
+void explorer_t::yield()
+{
+	std::unique_lock lock{m_Lock};
+	const auto self = current_index;
+	const auto next = pick(self);
+	if(next != self) switch_to(lock, self, next);
+}
+
+void explorer_t::join(size_t thread)
+{
+	std::unique_lock lock{m_Lock};
+	const auto self = current_index;
+	while(!m_Threads[thread].done)
+	{
+		m_Threads[self].joining = thread;
+		const auto next			= pick(self);
+		if(except(next == no_thread, std::runtime_error("every explored thread is waiting on another thread")))
+		{
+			m_Threads[self].joining = no_thread;
+			return;
+		}
+		switch_to(lock, self, next);
+	}
+	m_Threads[self].joining = no_thread;
+
+	auto handle = std::move(m_Threads[thread].handle);
+	lock.unlock();
+	if(handle.joinable()) handle.join();
+}
+
+auto explorer_t::describe() const -> std::string
+{
+	constexpr size_t max_segments{32};
+	std::string res{};
+	for(size_t i = 0; i < m_Trace.size(); ++i)
+	{
+		if(i == max_segments)
+		{
+			res += " ... (" + std::to_string(m_Trace.size() - i) + " more)";
+			break;
+		}
+		if(!res.empty()) res += ' ';
+		res += std::to_string(m_Trace[i].first) + ":" + std::to_string(m_Trace[i].second);
+	}
+	return res;
+}
+
+auto explorer_t::next_prefix(const std::vector<decision_t>& decisions) -> std::optional<std::vector<size_t>>
+{
+	for(size_t i = decisions.size(); i-- > 0;)
+	{
+		if(decisions[i].chosen + 1 >= decisions[i].options) continue;
+		std::vector<size_t> res{};
+		res.reserve(i + 1);
+		for(size_t j = 0; j < i; ++j) res.emplace_back(decisions[j].chosen);
+		res.emplace_back(decisions[i].chosen + 1);
+		return res;
+	}
+	return std::nullopt;
+}
+
+auto explorer_t::runnable(size_t index) const noexcept -> bool
+{
+	const auto& thread = m_Threads[index];
+	return !thread.done && (thread.joining == no_thread || m_Threads[thread.joining].done);
+}
+
+auto explorer_t::pick(size_t self) -> size_t
+{
+	// the other threads in round robin order, the calling thread last
+	std::vector<size_t> options{};
+	for(size_t i = 1; i <= m_Threads.size(); ++i)
+	{
+		const auto index = (self + i) % m_Threads.size();
+		if(runnable(index)) options.emplace_back(index);
+	}
+	if(options.empty()) return no_thread;
+
+	++m_Steps;
+	size_t chosen{0};
+	if(options.size() > 1 && !exceeded())
+	{
+		const auto decision = m_Decisions.size();
+		if(decision < m_Prefix.size())
+			chosen = std::min(m_Prefix[decision], options.size() - 1);
+		else if(m_Strategy == explore_strategy_t::random)
+			chosen = static_cast<size_t>(m_Prng.below(options.size()));
+		m_Decisions.emplace_back(decision_t{chosen, options.size(), options[chosen]});
+	}
+
+	const auto next = options[chosen];
+	if(m_Trace.empty() || m_Trace.back().first != next)
+		m_Trace.emplace_back(next, 1u);
+	else
+		++m_Trace.back().second;
+	return next;
+}
+
+void explorer_t::switch_to(std::unique_lock<std::mutex>& lock, size_t self, size_t next)
+{
+	m_Running = next;
+	m_Turn.notify_all();
+	m_Turn.wait(lock, [this, self]() { return m_Running == self; });
+}
+
+void explorer_t::finish(size_t self)
+{
+	std::lock_guard lock{m_Lock};
+	m_Threads[self].done = true;
+	const auto next		 = pick(self);
+	if(next == no_thread) return;
+	m_Running = next;
+	m_Turn.notify_all();
+}
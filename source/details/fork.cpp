@@ -0,0 +1,185 @@
+#include <litmus/details/fork.hpp>
+
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include <litmus/details/context.hpp>
+#include <litmus/details/exceptions.hpp>
+#include <litmus/details/progress.hpp>
+#include <litmus/details/serialize.hpp>
+#include <litmus/details/test_result.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LITMUS_FORK_SUPPORTED
+#include <cerrno>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace litmus::internal;
+
+namespace
+{
+	struct fork_state_t
+	{
+		bool active{false};
+		bool forked{false};
+		bool crashed{false};
+		int fd{-1};
+	} state{};
+
+#ifdef LITMUS_FORK_SUPPORTED
+	auto wait_for(pid_t pid) noexcept -> bool
+	{
+		int status{0};
+		while(waitpid(pid, &status, 0) < 0)
+		{
+			if(errno != EINTR) return false;
+		}
+		return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+
+	void write_all(int fd, std::string_view data) noexcept
+	{
+		while(!data.empty())
+		{
+			const auto written = ::write(fd, data.data(), data.size());
+			if(written < 0)
+			{
+				if(errno == EINTR) continue;
+				state.crashed = true;
+				return;
+			}
+			data.remove_prefix(static_cast<size_t>(written));
+		}
+	}
+
+	auto read_all(int fd) -> std::string
+	{
+		std::string res{};
+		char buffer[1u << 16u];
+		while(true)
+		{
+			const auto size = ::read(fd, buffer, sizeof(buffer));
+			if(size == 0) break;
+			if(size < 0)
+			{
+				if(errno == EINTR) continue;
+				break;
+			}
+			res.append(buffer, static_cast<size_t>(size));
+		}
+		return res;
+	}
+#endif
+} // namespace
+
+auto litmus::internal::fork::supported() noexcept -> bool
+{
+#ifdef LITMUS_FORK_SUPPORTED
+	return true;
+#else
+	return false;
+#endif
+}
+
+auto litmus::internal::fork::active() noexcept -> bool { return state.active; }
+
+void litmus::internal::fork::flush_streams()
+{
+	std::cout.flush();
+	std::cerr.flush();
+	std::fflush(nullptr);
+}
+
+auto litmus::internal::fork::run(const std::function<void()>& body) -> std::vector<test_result_t>
+{
+	std::vector<test_result_t> paths{};
+#ifdef LITMUS_FORK_SUPPORTED
+	int fds[2]{-1, -1};
+	if(except(::pipe(fds) != 0, std::runtime_error("could not create a pipe for '--fork-sections'"))) return paths;
+
+	auto guard = progress_reporter_t::fork_guard();
+	flush_streams();
+	const auto pid = ::fork();
+	guard.unlock();
+	if(pid == 0)
+	{
+		::close(fds[0]);
+		state = {true, false, false, fds[1]};
+		int status{0};
+		try
+		{
+			body();
+			// only processes that did not hand off a section executed a complete path
+			if(!state.forked)
+			{
+				std::string buffer{};
+				suite_context.output.serialize(buffer);
+				write_all(state.fd, buffer);
+			}
+		}
+		catch(...)
+		{
+			status = 2;
+		}
+		if(state.crashed && status == 0) status = 1;
+		flush_streams();
+		::_exit(status);
+	}
+
+	::close(fds[1]);
+	if(except(pid < 0, std::runtime_error("could not fork for '--fork-sections'")))
+	{
+		::close(fds[0]);
+		return paths;
+	}
+
+	const auto data = read_all(fds[0]);
+	::close(fds[0]);
+	const auto success = wait_for(pid);
+
+	binary_reader_t reader{data};
+	for(test_result_t path{}; path.deserialize(reader); path = {}) paths.emplace_back(std::move(path));
+
+	if(!success)
+	{
+		auto& path = paths.emplace_back(suite_context.output);
+		path.expect_result("", "", "", "", test_result_t::expect_t::operation_t::equal, false, true,
+						   "a forked section terminated abnormally, its results are missing");
+	}
+#else
+	std::ignore = body;
+	except(std::runtime_error("'--fork-sections' is not supported on this platform"));
+#endif
+	return paths;
+}
+
+auto litmus::internal::fork::section() noexcept -> bool
+{
+#ifdef LITMUS_FORK_SUPPORTED
+	auto guard = progress_reporter_t::fork_guard();
+	flush_streams();
+	const auto pid = ::fork();
+	guard.unlock();
+	if(pid == 0)
+	{
+		state.forked = false;
+		return true;
+	}
+	if(pid < 0)
+	{
+		state.crashed = true;
+		return false;
+	}
+
+	state.forked = true;
+	if(!wait_for(pid)) state.crashed = true;
+	return false;
+#else
+	return true;
+#endif
+}
@@ -0,0 +1,91 @@
+#include <litmus/details/isolation.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <string_view>
+#include <thread>
+
+#if defined(__linux__)
+#define LITMUS_AFFINITY_SUPPORTED
+#include <sched.h>
+#endif
+
+using namespace litmus::internal;
+
+namespace
+{
+	// first line of `filename`, none when it can't be read (e.g. the platform or driver does not expose it)
+	auto read_line(const std::string& filename) -> std::optional<std::string>
+	{
+		std::ifstream stream(filename);
+		std::string res{};
+		if(!stream.is_open() || !std::getline(stream, res)) return std::nullopt;
+		return res;
+	}
+} // namespace
+
+cpu_pin_t::cpu_pin_t([[maybe_unused]] std::optional<size_t> cpu)
+{
+#ifdef LITMUS_AFFINITY_SUPPORTED
+	cpu_set_t previous{};
+	if(sched_getaffinity(0, sizeof(previous), &previous) != 0) return;
+	if(!cpu)
+	{
+		const auto current = sched_getcpu();
+		if(current < 0) return;
+		cpu = static_cast<size_t>(current);
+	}
+	if(*cpu >= CPU_SETSIZE) return;
+
+	cpu_set_t pinned{};
+	CPU_ZERO(&pinned);
+	CPU_SET(*cpu, &pinned);
+	if(sched_setaffinity(0, sizeof(pinned), &pinned) != 0) return;
+
+	m_Cpu = cpu;
+	for(size_t i = 0; i < CPU_SETSIZE; ++i)
+		if(CPU_ISSET(i, &previous)) m_Previous.emplace_back(i);
+#endif
+}
+
+cpu_pin_t::~cpu_pin_t()
+{
+#ifdef LITMUS_AFFINITY_SUPPORTED
+	if(!m_Cpu) return;
+	cpu_set_t previous{};
+	CPU_ZERO(&previous);
+	for(auto i : m_Previous) CPU_SET(i, &previous);
+	sched_setaffinity(0, sizeof(previous), &previous);
+#endif
+}
+
+auto litmus::internal::noisy_environment(std::optional<size_t> cpu) -> std::vector<std::string>
+{
+	std::vector<std::string> res{};
+	const std::string root{"/sys/devices/system/cpu/"};
+
+	const auto cores = static_cast<size_t>(std::thread::hardware_concurrency());
+	for(size_t i = cpu.value_or(0); i < (cpu ? *cpu + 1 : cores); ++i)
+	{
+		const auto governor = read_line(root + "cpu" + std::to_string(i) + "/cpufreq/scaling_governor");
+		if(!governor || *governor == "performance") continue;
+		res.emplace_back("cpu " + std::to_string(i) + " uses the '" + *governor +
+						 "' frequency governor, timings depend on the clock speed it picks");
+		if(!cpu) break;
+	}
+
+	if(read_line(root + "cpufreq/boost") == "1")
+		res.emplace_back("frequency boost is enabled, the clock speed depends on the temperature of the cpu");
+	else if(read_line(root + "intel_pstate/no_turbo") == "0")
+		res.emplace_back("turbo boost is enabled, the clock speed depends on the temperature of the cpu");
+
+	// "0.52 0.58 0.59 1/467 12345", the first field is the load average of the last minute
+	if(const auto loadavg = read_line("/proc/loadavg"); loadavg)
+	{
+		const auto load = std::strtod(loadavg->c_str(), nullptr);
+		if(load >= 1.0)
+			res.emplace_back("the load average is " + loadavg->substr(0, loadavg->find(' ')) +
+							 ", other processes compete for the cpu");
+	}
+	return res;
+}
@@ -0,0 +1,201 @@
+#include <litmus/details/listing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <litmus/details/durations.hpp>
+#include <litmus/details/histogram.hpp>
+#include <litmus/details/runner.hpp>
+
+using namespace litmus;
+using namespace litmus::internal;
+
+namespace
+{
+	// a single registration, its permutations are numbered from `ordinal` on within its template arguments
+	struct entry_t
+	{
+		const char* name;
+		bool benchmark;
+		const std::vector<std::string>* templates;
+		const permutations_t* permutations;
+		size_t ordinal;
+	};
+
+	void append_json(std::string& output, std::string_view value)
+	{
+		output += '"';
+		for(auto ch : value)
+		{
+			switch(ch)
+			{
+			case '"':
+				output += "\\\"";
+				break;
+			case '\\':
+				output += "\\\\";
+				break;
+			case '\n':
+				output += "\\n";
+				break;
+			case '\t':
+				output += "\\t";
+				break;
+			default:
+				if(static_cast<unsigned char>(ch) < 0x20u)
+				{
+					constexpr std::string_view digits{"0123456789abcdef"};
+					output += "\\u00";
+					output += digits[static_cast<unsigned char>(ch) >> 4u];
+					output += digits[static_cast<unsigned char>(ch) & 0xFu];
+				}
+				else
+					output += ch;
+			}
+		}
+		output += '"';
+	}
+
+	template <typename T>
+	void append_json_array(std::string& output, const T& values)
+	{
+		output += '[';
+		for(size_t i = 0; i < std::size(values); ++i)
+		{
+			if(i > 0) output += ", ";
+			append_json(output, values[i]);
+		}
+		output += ']';
+	}
+
+	template <typename T>
+	void append_list(std::string& output, const T& values, std::string_view open, std::string_view close)
+	{
+		output += open;
+		for(size_t i = 0; i < std::size(values); ++i)
+		{
+			if(i > 0) output += ", ";
+			output += values[i];
+		}
+		output += close;
+	}
+
+	// the recorded durations of the permutations, or the mean of the recorded ones for those that have none
+	auto estimate(const entry_t& entry, const duration_history_t* history)
+		-> std::vector<std::optional<std::chrono::microseconds>>
+	{
+		std::vector<std::optional<std::chrono::microseconds>> res(entry.permutations->size());
+		if(history == nullptr || history->empty()) return res;
+
+		std::chrono::microseconds total{0};
+		size_t known{0};
+		for(size_t i = 0; i < res.size(); ++i)
+		{
+			res[i] = history->find(duration_history_t::key(entry.name, *entry.templates, entry.ordinal + i));
+			if(!res[i]) continue;
+			total += *res[i];
+			++known;
+		}
+		if(known == 0 || known == res.size()) return res;
+		const auto mean = total / static_cast<std::chrono::microseconds::rep>(known);
+		for(auto& cost : res)
+			if(!cost) cost = mean;
+		return res;
+	}
+} // namespace
+
+void litmus::internal::list_permutations(std::ostream& stream, list_format_t format,
+										 const duration_history_t* history)
+{
+	std::vector<entry_t> entries{};
+	auto gather = [&entries](const auto& suites, bool benchmark) {
+		for(const auto& [name, test_units] : suites)
+		{
+			for(const auto& [uid, tests] : test_units)
+			{
+				size_t ordinal{0};
+				for(const auto& permutations : tests.permutations)
+				{
+					entries.emplace_back(entry_t{name, benchmark, &tests.templates, permutations.get(), ordinal});
+					ordinal += permutations->size();
+				}
+			}
+		}
+	};
+	gather(runner, false);
+	gather(runner.benchmarks(), true);
+
+	// the registries are unordered, the listing should be the same for every run of the same binary
+	std::sort(std::begin(entries), std::end(entries), [](const entry_t& lhs, const entry_t& rhs) {
+		return std::forward_as_tuple(lhs.benchmark, std::string_view{lhs.name}, *lhs.templates, lhs.ordinal) <
+			   std::forward_as_tuple(rhs.benchmark, std::string_view{rhs.name}, *rhs.templates, rhs.ordinal);
+	});
+
+	std::string output{};
+	if(format == list_format_t::json) output += "[";
+	for(size_t e = 0; e < entries.size(); ++e)
+	{
+		const auto& entry	  = entries[e];
+		const auto& location  = entry.permutations->location();
+		const auto costs	  = estimate(entry, history);
+		const auto source	  = std::string{location.file_name()} + ":" + std::to_string(location.line());
+		const auto categories = entry.permutations->categories();
+
+		if(format == list_format_t::json)
+		{
+			output += (e == 0) ? "{\n\t\"name\": " : ",{\n\t\"name\": ";
+			append_json(output, entry.name);
+			output += ",\n\t\"benchmark\": ";
+			output += entry.benchmark ? "true" : "false";
+			output += ",\n\t\"source\": ";
+			append_json(output, source);
+			output += ",\n\t\"templates\": ";
+			append_json_array(output, *entry.templates);
+			output += ",\n\t\"categories\": ";
+			append_json_array(output, categories);
+			output += ",\n\t\"permutations\": [";
+			for(size_t i = 0; i < costs.size(); ++i)
+			{
+				output += (i == 0) ? "\n\t\t{\"ordinal\": " : ",\n\t\t{\"ordinal\": ";
+				output += std::to_string(entry.ordinal + i);
+				output += ", \"parameters\": ";
+				append_json_array(output, entry.permutations->describe(i));
+				if(costs[i])
+				{
+					output += ", \"cost_microseconds\": ";
+					output += std::to_string(costs[i]->count());
+				}
+				output += '}';
+			}
+			output += "]\n}";
+		}
+		else
+		{
+			// "name<templates> { parameters } file:line [categories] ~cost", one line per permutation
+			for(size_t i = 0; i < costs.size(); ++i)
+			{
+				output += entry.name;
+				if(!entry.templates->empty()) append_list(output, *entry.templates, "<", ">");
+				const auto parameters = entry.permutations->describe(i);
+				if(!parameters.empty()) append_list(output, parameters, " { ", " }");
+				output += ' ';
+				output += source;
+				if(!categories.empty()) append_list(output, categories, " [", "]");
+				if(entry.benchmark) output += " (benchmark)";
+				if(costs[i])
+				{
+					output += " ~";
+					output += nanoseconds_to_string(static_cast<double>(costs[i]->count()) * 1000.0);
+				}
+				output += '\n';
+			}
+		}
+	}
+	if(format == list_format_t::json) output += "]\n";
+	stream << output << std::flush;
+}
@@ -0,0 +1,148 @@
+#include <litmus/details/mapped_file.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <utility>
+
+#include <litmus/details/exceptions.hpp>
+#include <litmus/details/utility.hpp>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace litmus::internal;
+
+mapped_file_t::mapped_file_t(const std::string& filename)
+{
+	std::error_code error{};
+	*this = mapped_file_t{filename, error};
+	except(error.operator bool(),
+		   std::runtime_error(combine_text("could not map file '", filename, "': ", error.message())));
+}
+
+mapped_file_t::mapped_file_t(const std::string& filename, std::error_code& error) noexcept
+{
+	error.clear();
+#if defined(_WIN32)
+	auto last_error = [&error]() { error = std::error_code(static_cast<int>(GetLastError()), std::system_category()); };
+
+	m_File = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+						 FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(m_File == INVALID_HANDLE_VALUE)
+	{
+		last_error();
+		m_File = nullptr;
+		return;
+	}
+	LARGE_INTEGER size{};
+	if(!GetFileSizeEx(m_File, &size))
+	{
+		last_error();
+		close();
+		return;
+	}
+	m_Size = static_cast<size_t>(size.QuadPart);
+	if(m_Size == 0) return;
+
+	m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(m_Mapping == nullptr)
+	{
+		last_error();
+		close();
+		return;
+	}
+	m_Data = static_cast<const std::byte*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+	if(m_Data == nullptr)
+	{
+		last_error();
+		close();
+	}
+#else
+	const auto fd = ::open(filename.c_str(), O_RDONLY);
+	if(fd < 0)
+	{
+		error = std::error_code(errno, std::generic_category());
+		return;
+	}
+
+	struct stat info
+	{};
+	if(::fstat(fd, &info) != 0)
+	{
+		error = std::error_code(errno, std::generic_category());
+		::close(fd);
+		return;
+	}
+	if(info.st_size == 0)
+	{
+		::close(fd);
+		return;
+	}
+
+	auto* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if(data == MAP_FAILED)
+	{
+		error = std::error_code(errno, std::generic_category());
+		::close(fd);
+		return;
+	}
+	::close(fd);
+
+	m_Data = static_cast<const std::byte*>(data);
+	m_Size = static_cast<size_t>(info.st_size);
+#endif
+}
+
+mapped_file_t::~mapped_file_t() { close(); }
+
+mapped_file_t::mapped_file_t(mapped_file_t&& other) noexcept { *this = std::move(other); }
+
+auto mapped_file_t::operator=(mapped_file_t&& other) noexcept -> mapped_file_t&
+{
+	if(this != &other)
+	{
+		close();
+		m_Data = std::exchange(other.m_Data, nullptr);
+		m_Size = std::exchange(other.m_Size, 0u);
+#if defined(_WIN32)
+		m_File	  = std::exchange(other.m_File, nullptr);
+		m_Mapping = std::exchange(other.m_Mapping, nullptr);
+#endif
+	}
+	return *this;
+}
+
+void mapped_file_t::sequential([[maybe_unused]] size_t offset, [[maybe_unused]] size_t size) const noexcept
+{
+#if !defined(_WIN32)
+	if(m_Data == nullptr || offset >= m_Size) return;
+	static const auto page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	const auto begin			= offset - (offset % page_size);
+	::madvise(const_cast<std::byte*>(m_Data) + begin, std::min(size + (offset - begin), m_Size - begin),
+			  MADV_SEQUENTIAL);
+#endif
+}
+
+void mapped_file_t::close() noexcept
+{
+#if defined(_WIN32)
+	if(m_Data != nullptr) UnmapViewOfFile(m_Data);
+	if(m_Mapping != nullptr) CloseHandle(m_Mapping);
+	if(m_File != nullptr) CloseHandle(m_File);
+	m_File	  = nullptr;
+	m_Mapping = nullptr;
+#else
+	if(m_Data != nullptr) ::munmap(const_cast<std::byte*>(m_Data), m_Size);
+#endif
+	m_Data = nullptr;
+	m_Size = 0;
+}
@@ -0,0 +1,165 @@
+#include <litmus/details/progress.hpp>
+
+#include <cstdio>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <litmus/details/durations.hpp>
+#include <litmus/details/runner.hpp>
+#include <litmus/details/test_result.hpp>
+
+using namespace litmus::internal;
+
+namespace
+{
+	// see `progress_reporter_t::fork_guard`
+	std::mutex fork_mutex{};
+
+	// "m:ss", or "h:mm:ss" once it takes an hour
+	auto clock_text(std::chrono::seconds duration) -> std::string
+	{
+		const auto hours   = std::chrono::duration_cast<std::chrono::hours>(duration);
+		const auto minutes = std::chrono::duration_cast<std::chrono::minutes>(duration - hours);
+		const auto seconds = duration - hours - minutes;
+		auto two_digits = [](auto value) { return (value.count() < 10 ? "0" : "") + std::to_string(value.count()); };
+		if(hours.count() > 0)
+			return std::to_string(hours.count()) + ":" + two_digits(minutes) + ":" + two_digits(seconds);
+		return std::to_string(minutes.count()) + ":" + two_digits(seconds);
+	}
+} // namespace
+
+progress_reporter_t::progress_reporter_t(std::chrono::milliseconds interval, size_t permutations, size_t suites,
+										 std::optional<std::chrono::microseconds> expected)
+	: m_Interval(interval), m_TotalPermutations(permutations), m_TotalSuites(suites), m_Expected(expected)
+{
+	m_Thread = std::thread([this] {
+		std::unique_lock lock{m_Mutex};
+		while(!m_Wake.wait_for(lock, m_Interval, [this] { return m_Stop; })) report();
+	});
+}
+
+progress_reporter_t::~progress_reporter_t()
+{
+	{
+		std::scoped_lock lock{m_Mutex};
+		m_Stop = true;
+	}
+	m_Wake.notify_one();
+	m_Thread.join();
+	std::scoped_lock guard{fork_mutex};
+	if(m_Drawn) std::cerr << "\r\x1b[K" << std::flush;
+}
+
+void progress_reporter_t::permutation_done(const test_result_t& result) noexcept
+{
+	m_Permutations.fetch_add(1, std::memory_order_relaxed);
+	// permutations that were filtered out have no results
+	if(result.results.empty()) return;
+	const auto& root = result.root();
+	m_Expects.fetch_add(root.pass + root.fail + root.fatal, std::memory_order_relaxed);
+	if(root.fail + root.fatal > 0) m_Failures.fetch_add(root.fail + root.fatal, std::memory_order_relaxed);
+	m_Microseconds.fetch_add(std::chrono::duration_cast<std::chrono::microseconds>(root.duration()).count(),
+							 std::memory_order_relaxed);
+}
+
+auto progress_reporter_t::pause() -> std::unique_lock<std::mutex>
+{
+	std::unique_lock lock{m_Mutex};
+	std::scoped_lock guard{fork_mutex};
+	if(m_Drawn) std::cerr << "\r\x1b[K" << std::flush;
+	m_Drawn = false;
+	return lock;
+}
+
+auto progress_reporter_t::fork_guard() -> std::unique_lock<std::mutex> { return std::unique_lock{fork_mutex}; }
+
+auto progress_reporter_t::terminal() noexcept -> bool
+{
+#if defined(_WIN32)
+	return _isatty(_fileno(stderr)) != 0;
+#else
+	return ::isatty(::fileno(stderr)) != 0;
+#endif
+}
+
+void progress_reporter_t::report()
+{
+	std::scoped_lock guard{fork_mutex};
+	if(m_Terminal)
+		std::cerr << '\r' << status() << "\x1b[K" << std::flush;
+	else
+		std::cerr << "progress: " << status() << std::endl;
+	m_Drawn = m_Terminal;
+}
+
+auto progress_reporter_t::status() const -> std::string
+{
+	const auto permutations = m_Permutations.load(std::memory_order_relaxed);
+	const auto elapsed		= std::chrono::steady_clock::now() - m_Start;
+	const auto measured		= std::chrono::microseconds{m_Microseconds.load(std::memory_order_relaxed)};
+
+	/*
+		the remaining cost of the history at the rate it's being worked off (the measured durations over the elapsed
+		time, which accounts for the suites running in parallel), or the remaining permutations at the rate they
+		finished so far when there's no history to go by
+	*/
+	std::optional<std::chrono::seconds> remaining{};
+	if(m_Expected && measured.count() > 0 && measured < *m_Expected)
+	{
+		const auto left = static_cast<double>((*m_Expected - measured).count()) / static_cast<double>(measured.count());
+		remaining		= std::chrono::duration_cast<std::chrono::seconds>(elapsed * left);
+	}
+	else if(permutations > 0 && permutations < m_TotalPermutations)
+		remaining = std::chrono::duration_cast<std::chrono::seconds>(elapsed * (m_TotalPermutations - permutations) /
+																	 permutations);
+	else if(permutations == m_TotalPermutations)
+		remaining = std::chrono::seconds{0};
+
+	auto res = std::to_string(permutations) + "/" + std::to_string(m_TotalPermutations) + " runs, " +
+			   std::to_string(m_Suites.load(std::memory_order_relaxed)) + "/" + std::to_string(m_TotalSuites) +
+			   " suites | " + std::to_string(m_Expects.load(std::memory_order_relaxed)) + " expects, " +
+			   std::to_string(m_Failures.load(std::memory_order_relaxed)) + " failed | " +
+			   clock_text(std::chrono::duration_cast<std::chrono::seconds>(elapsed)) + " elapsed";
+	if(remaining) res += ", ~" + clock_text(*remaining) + " left";
+	return res;
+}
+
+auto litmus::internal::expected_duration(const duration_history_t& history, bool tests, bool benchmarks)
+	-> std::optional<std::chrono::microseconds>
+{
+	if(history.empty()) return std::nullopt;
+	std::chrono::microseconds total{0};
+	size_t known{0};
+	size_t unknown{0};
+	auto gather = [&](const auto& suites) {
+		for(const auto& [name, test_units] : suites)
+		{
+			for(const auto& [uid, tests] : test_units)
+			{
+				size_t ordinal{0};
+				for(const auto& permutations : tests.permutations)
+				{
+					for(size_t i = 0; i < permutations->size(); ++i, ++ordinal)
+					{
+						if(const auto cost = history.find(duration_history_t::key(name, tests.templates, ordinal)))
+						{
+							total += *cost;
+							++known;
+						}
+						else
+							++unknown;
+					}
+				}
+			}
+		}
+	};
+	if(tests) gather(runner);
+	if(benchmarks) gather(runner.benchmarks());
+	if(known == 0) return std::nullopt;
+	return total + total * static_cast<std::int64_t>(unknown) / static_cast<std::int64_t>(known);
+}
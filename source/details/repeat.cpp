@@ -0,0 +1,98 @@
+#include <litmus/details/repeat.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include <litmus/details/histogram.hpp>
+#include <litmus/details/utility.hpp>
+
+using namespace litmus::internal;
+
+namespace
+{
+	// permutations that were filtered out have no results, and don't fail
+	auto failed(const test_result_t& result) -> bool
+	{
+		if(result.results.empty()) return false;
+		const auto& root = result.root();
+		return root.fail > 0 || root.fatal > 0;
+	}
+} // namespace
+
+auto repeat::active() noexcept -> bool
+{
+	return runs() > 1 || config->rerun_failed > 0;
+}
+
+auto repeat::runs() noexcept -> size_t
+{
+	if(config->until_fail && config->repeat <= 1) return LITMUS_UNTIL_FAIL_RUNS;
+	return std::max<size_t>(config->repeat, 1);
+}
+
+auto repeat::attempt(const std::function<test_result_t()>& run) -> test_result_t
+{
+	auto result = run();
+	for(size_t retry = 1; retry <= config->rerun_failed && failed(result); ++retry)
+	{
+		result		   = run();
+		result.retries = retry;
+	}
+	return result;
+}
+
+auto repeat::again(const std::vector<test_result_t>& runs) -> bool
+{
+	if(runs.empty()) return true;
+	if(runs.back().results.empty()) return false;
+	if(config->until_fail && failed(runs.back())) return false;
+	return runs.size() < repeat::runs();
+}
+
+auto repeat::fold(std::vector<test_result_t> runs, const permutations_t& permutations, size_t index) -> folded_t
+{
+	if(config->until_fail)
+	{
+		const auto first = std::find_if(std::begin(runs), std::end(runs), [](const auto& run) { return failed(run); });
+		if(first != std::end(runs)) runs.erase(std::next(first), std::end(runs));
+	}
+	if(repeat::runs() == 1 && runs.size() == 1 && runs[0].retries == 0) return {std::move(runs[0]), false};
+	if(runs.empty() || runs[0].results.empty()) return {runs.empty() ? test_result_t{} : std::move(runs[0]), false};
+
+	size_t passed{0};
+	size_t retries{0};
+	bool passed_on_retry{false};
+	double sum{0.0};
+	for(const auto& run : runs)
+	{
+		passed += failed(run) ? 0 : 1;
+		retries += run.retries;
+		passed_on_retry |= run.retries > 0 && !failed(run);
+		sum += static_cast<double>(run.root().duration().count());
+	}
+	const auto count = static_cast<double>(runs.size());
+	const auto mean	 = sum / count;
+	double squares{0.0};
+	for(const auto& run : runs) squares += std::pow(static_cast<double>(run.root().duration().count()) - mean, 2.0);
+	const auto deviation = (runs.size() > 1) ? std::sqrt(squares / (count - 1.0)) : 0.0;
+	const auto flaky	 = passed_on_retry || (passed > 0 && passed < runs.size());
+
+	// the first failing run is the one worth reading
+	auto reported = std::find_if(std::begin(runs), std::end(runs), [](const auto& run) { return failed(run); });
+	if(reported == std::end(runs)) reported = std::prev(std::end(runs));
+	auto result = std::move(*reported);
+
+	auto summary = combine_text(std::to_string(passed), "/", std::to_string(runs.size()), " runs passed (",
+								std::to_string(std::lround(100.0 * static_cast<double>(passed) / count)), "%)");
+	if(runs.size() > 1)
+		summary += combine_text(", ", nanoseconds_to_string(mean), " ± ", nanoseconds_to_string(deviation));
+	if(retries > 0) summary += ", " + std::to_string(retries) + ((retries == 1) ? " retry" : " retries");
+	if(flaky) summary += ", flaky";
+
+	auto& root = std::get<test_result_t::scope_t>(result.results[0]);
+	if(root.parameters.empty()) root.parameters = permutations.describe(index);
+	root.parameters.emplace_back(std::move(summary));
+	return {std::move(result), flaky};
+}
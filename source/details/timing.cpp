@@ -0,0 +1,68 @@
+#include <litmus/details/timing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#if defined(LITMUS_TSC_SUPPORTED) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#endif
+
+using namespace litmus::internal;
+
+timing::state_t timing::state{};
+
+namespace
+{
+	// the tsc only measures time when it ticks at a constant rate, regardless of frequency scaling and sleep states
+	auto invariant_tsc() noexcept -> bool
+	{
+#if defined(LITMUS_TSC_SUPPORTED) && (defined(__GNUC__) || defined(__clang__))
+		unsigned int eax{}, ebx{}, ecx{}, edx{};
+		if(__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx) == 0) return false;
+		return (edx & (1u << 8u)) != 0u;
+#elif defined(LITMUS_TSC_SUPPORTED)
+		int registers[4]{};
+		__cpuid(registers, static_cast<int>(0x80000007u));
+		return (static_cast<unsigned int>(registers[3]) & (1u << 8u)) != 0u;
+#else
+		return false;
+#endif
+	}
+} // namespace
+
+auto timing::select(clock_source_t source) -> bool
+{
+	switch(source)
+	{
+	case clock_source_t::steady:
+		state = {source, state.scopes};
+		return true;
+	case clock_source_t::tsc:
+	{
+		if(!invariant_tsc()) return false;
+		// ticks per nanosecond over a short busy wait
+		using clock		 = std::chrono::steady_clock;
+		const auto begin = clock::now();
+		state.source	 = source;
+		const auto start = timing::now();
+		while(clock::now() - begin < std::chrono::milliseconds(20)) std::this_thread::yield();
+		const auto end	   = timing::now();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - begin);
+		state.nanoseconds_per_tick =
+			static_cast<double>(elapsed.count()) / static_cast<double>(std::max<std::uint64_t>(end - start, 1u));
+		return true;
+	}
+	case clock_source_t::monotonic_raw:
+#ifdef LITMUS_MONOTONIC_RAW_SUPPORTED
+		state = {source, state.scopes, 1.0};
+		return true;
+#else
+		return false;
+#endif
+	case clock_source_t::none:
+		state = {source, state.scopes, 0.0};
+		return true;
+	}
+	return false;
+}
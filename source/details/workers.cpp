@@ -0,0 +1,289 @@
+#include <litmus/details/workers.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <litmus/details/exceptions.hpp>
+#include <litmus/details/fork.hpp>
+#include <litmus/details/progress.hpp>
+#include <litmus/details/serialize.hpp>
+#include <litmus/details/test_result.hpp>
+#include <litmus/details/utility.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LITMUS_WORKERS_SUPPORTED
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace litmus::internal;
+
+namespace
+{
+#ifdef LITMUS_WORKERS_SUPPORTED
+#ifdef MSG_NOSIGNAL
+	constexpr int send_flags{MSG_NOSIGNAL};
+#else
+	constexpr int send_flags{0};
+#endif
+
+	struct worker_t
+	{
+		pid_t pid{-1};
+		int fd{-1};
+		// the item the worker is running, if any, and when it was handed out
+		std::optional<size_t> item{};
+		std::chrono::steady_clock::time_point started{};
+		// a partially received result record
+		std::string buffer{};
+	};
+
+	// a worker that exits early must not take the runner down with a SIGPIPE
+	auto send_all(int fd, std::string_view data) noexcept -> bool
+	{
+		while(!data.empty())
+		{
+			const auto sent = ::send(fd, data.data(), data.size(), send_flags);
+			if(sent < 0)
+			{
+				if(errno == EINTR) continue;
+				return false;
+			}
+			data.remove_prefix(static_cast<size_t>(sent));
+		}
+		return true;
+	}
+
+	auto receive_all(int fd, void* data, size_t size) noexcept -> bool
+	{
+		auto* bytes = static_cast<char*>(data);
+		while(size > 0)
+		{
+			const auto received = ::recv(fd, bytes, size, 0);
+			if(received == 0) return false;
+			if(received < 0)
+			{
+				if(errno == EINTR) continue;
+				return false;
+			}
+			bytes += received;
+			size -= static_cast<size_t>(received);
+		}
+		return true;
+	}
+
+	// runs the items the runner sends until it closes the socket, never returns
+	[[noreturn]] void serve(int fd, const std::function<test_result_t(size_t)>& run) noexcept
+	{
+		int status{0};
+		try
+		{
+			std::uint64_t item{0};
+			std::string buffer{};
+			while(receive_all(fd, &item, sizeof(item)))
+			{
+				buffer.clear();
+				run(static_cast<size_t>(item)).serialize(buffer);
+				if(!send_all(fd, buffer))
+				{
+					status = 1;
+					break;
+				}
+			}
+		}
+		catch(...)
+		{
+			status = 2;
+		}
+		fork::flush_streams();
+		::_exit(status);
+	}
+
+	auto spawn(std::vector<worker_t>& workers, const std::function<test_result_t(size_t)>& run) -> bool
+	{
+		int fds[2]{-1, -1};
+		if(except(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0,
+				  std::runtime_error("could not create a socket for '--workers'")))
+			return false;
+
+		auto guard = progress_reporter_t::fork_guard();
+		fork::flush_streams();
+		const auto pid = ::fork();
+		guard.unlock();
+		if(pid == 0)
+		{
+			::close(fds[0]);
+			for(const auto& worker : workers)
+				if(worker.fd >= 0) ::close(worker.fd);
+			serve(fds[1], run);
+		}
+
+		::close(fds[1]);
+		if(except(pid < 0, std::runtime_error("could not fork a worker for '--workers'")))
+		{
+			::close(fds[0]);
+			return false;
+		}
+		workers.emplace_back(worker_t{pid, fds[0]});
+		return true;
+	}
+
+	// closes the connection and reaps the worker, returns its wait status
+	auto stop(worker_t& worker) noexcept -> int
+	{
+		::close(std::exchange(worker.fd, -1));
+		int status{0};
+		while(waitpid(worker.pid, &status, 0) < 0 && errno == EINTR) {}
+		return status;
+	}
+
+	auto termination(int status) -> std::string
+	{
+		if(WIFSIGNALED(status))
+		{
+			const auto* name = ::strsignal(WTERMSIG(status));
+			return combine_text("killed by signal ", std::to_string(WTERMSIG(status)),
+								(name != nullptr) ? combine_text(" (", std::string{name}, ")") : std::string{});
+		}
+		if(WIFEXITED(status)) return combine_text("exited with status ", std::to_string(WEXITSTATUS(status)));
+		return "terminated abnormally";
+	}
+#endif
+} // namespace
+
+auto litmus::internal::workers::supported() noexcept -> bool
+{
+#ifdef LITMUS_WORKERS_SUPPORTED
+	return true;
+#else
+	return false;
+#endif
+}
+
+auto litmus::internal::workers::run(size_t workers, size_t count, const std::function<test_result_t(size_t)>& run,
+								   const std::function<void(size_t, const std::optional<test_result_t>&)>& finished,
+								   std::optional<std::chrono::milliseconds> timeout) -> std::vector<outcome_t>
+{
+	using clock = std::chrono::steady_clock;
+	std::vector<outcome_t> res(count);
+#ifdef LITMUS_WORKERS_SUPPORTED
+	std::vector<worker_t> pool{};
+	for(size_t i = 0; i < std::min(workers, count); ++i)
+		if(!spawn(pool, run)) break;
+
+	size_t next{0};
+	size_t done{0};
+	std::vector<pollfd> fds{};
+	while(done < count)
+	{
+		// the item that was running (if any) is lost, the remaining work goes to a replacement
+		auto crashed = [&](worker_t& worker, const std::string& reason = {}) {
+			const auto status = stop(worker);
+			if(worker.item)
+			{
+				++done;
+				res[*worker.item].pid		  = static_cast<int>(worker.pid);
+				res[*worker.item].termination = reason.empty() ? termination(status) : reason;
+				if(finished) finished(*worker.item, res[*worker.item].result);
+			}
+			worker.item.reset();
+			if(next < count) spawn(pool, run);
+		};
+
+		for(size_t i = 0; i < pool.size(); ++i)
+		{
+			if(pool[i].fd < 0 || pool[i].item || next == count) continue;
+			const auto item = static_cast<std::uint64_t>(next);
+			pool[i].item	= next++;
+			pool[i].started = clock::now();
+			if(!send_all(pool[i].fd, {reinterpret_cast<const char*>(&item), sizeof(item)})) crashed(pool[i]);
+		}
+
+		fds.clear();
+		for(const auto& worker : pool)
+			if(worker.fd >= 0 && worker.item) fds.emplace_back(pollfd{worker.fd, POLLIN, 0});
+		if(fds.empty()) break;
+
+		// waits until the first of the running items would time out at most
+		int wait{-1};
+		if(timeout)
+		{
+			auto deadline = clock::time_point::max();
+			for(const auto& worker : pool)
+				if(worker.fd >= 0 && worker.item) deadline = std::min(deadline, worker.started + *timeout);
+			const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - clock::now()).count();
+			wait			= static_cast<int>(std::clamp<std::int64_t>(left, 0, std::numeric_limits<int>::max()));
+		}
+		if(::poll(fds.data(), static_cast<nfds_t>(fds.size()), wait) < 0)
+		{
+			if(errno == EINTR) continue;
+			except(std::runtime_error("could not wait for the '--workers'"));
+			break;
+		}
+
+		// a hanging item is only noticed through the timeout, its worker is killed and replaced
+		if(timeout)
+		{
+			bool killed{false};
+			const auto now = clock::now();
+			for(size_t i = 0; i < pool.size(); ++i)
+			{
+				if(pool[i].fd < 0 || !pool[i].item || now - pool[i].started < *timeout) continue;
+				::kill(pool[i].pid, SIGKILL);
+				crashed(pool[i], combine_text("timed out after ", std::to_string(timeout->count()), "ms"));
+				killed = true;
+			}
+			// the descriptors of the killed workers can be reused by their replacements, so they are polled again
+			if(killed) continue;
+		}
+
+		for(const auto& fd : fds)
+		{
+			if(fd.revents == 0) continue;
+			auto& worker = *std::find_if(std::begin(pool), std::end(pool),
+										 [&fd](const worker_t& worker) { return worker.fd == fd.fd; });
+			char buffer[1u << 16u];
+			const auto size = ::recv(worker.fd, buffer, sizeof(buffer), 0);
+			if(size < 0 && errno == EINTR) continue;
+			if(size <= 0)
+			{
+				crashed(worker);
+				continue;
+			}
+			worker.buffer.append(buffer, static_cast<size_t>(size));
+
+			binary_reader_t reader{worker.buffer};
+			if(test_result_t result{}; result.deserialize(reader))
+			{
+				res[*worker.item].result = std::move(result);
+				worker.buffer.erase(0, worker.buffer.size() - reader.remaining().size());
+				if(finished) finished(*worker.item, res[*worker.item].result);
+				worker.item.reset();
+				++done;
+			}
+		}
+	}
+
+	for(auto& worker : pool)
+		if(worker.fd >= 0) stop(worker);
+#else
+	std::ignore = workers;
+	std::ignore = run;
+	std::ignore = finished;
+	std::ignore = timeout;
+	except(std::runtime_error("'--workers' is not supported on this platform"));
+#endif
+	return res;
+}
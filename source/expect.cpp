@@ -110,6 +110,8 @@ void litmus::internal::evaluate(const source_location& source, test_result_t::ex
 				lhs_begin_scope = next + 1;
 				break;
 			}
+			// the keyword as part of another word or string, e.g. "expect.pass"
+			lhs_begin_scope += keyword.size();
 		}
 	}
 
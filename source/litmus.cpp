@@ -2,7 +2,9 @@
 #include <litmus/details/context.hpp>
 #include <litmus/litmus.hpp>
 thread_local litmus::internal::suite_context_t litmus::internal::suite_context = {};
+thread_local litmus::internal::remote_target_t litmus::internal::remote_target = {};
 
+#include <cstdlib>
 #include <exception>
 #include <fstream>
 #include <functional>
@@ -10,12 +12,22 @@ thread_local litmus::internal::suite_context_t litmus::internal::suite_context =
 #include <iostream>
 #include <ostream>
 #include <optional>
+#include <random>
+#include <sstream>
 #include <stdexcept>
 #include <string_view>
 #include <unordered_map>
 
+#include <litmus/details/event_loop.hpp>
 #include <litmus/details/exceptions.hpp>
+#include <litmus/details/durations.hpp>
+#include <litmus/details/fork.hpp>
+#include <litmus/details/isolation.hpp>
+#include <litmus/details/listing.hpp>
+#include <litmus/details/progress.hpp>
+#include <litmus/details/repeat.hpp>
 #include <litmus/details/test_result.hpp>
+#include <litmus/details/workers.hpp>
 
 
 #include <litmus/formatter/detailed.hpp>
@@ -78,6 +90,10 @@ class option
 
 void configure(std::span<const std::string_view> args)
 {
+	// fresh seed for every run unless one is given through '--seed'
+	internal::config->seed = (static_cast<std::uint64_t>(std::random_device{}()) << 32u) ^
+							 static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+
 	std::vector<option> options{
 		{"verbosity",
 		 [](std::span<const std::string_view> args) {
@@ -92,9 +108,49 @@ void configure(std::span<const std::string_view> args)
 		 },
 		 1},
 		{"rerun-failed",
-		 []([[maybe_unused]] std::span<const std::string_view> args) { internal::config->rerun_failed = true; }},
+		 [](std::span<const std::string_view> args) {
+			 internal::config->rerun_failed = args.empty() ? 1u : std::stoul(std::string(args[0]));
+		 },
+		 0, 1},
+		{"repeat",
+		 [](std::span<const std::string_view> args) { internal::config->repeat = std::stoul(std::string(args[0])); },
+		 1},
+		{"until-fail",
+		 []([[maybe_unused]] std::span<const std::string_view> args) { internal::config->until_fail = true; }},
 		{"single-threaded",
 		 []([[maybe_unused]] std::span<const std::string_view> args) { internal::config->single_threaded = true; }},
+		{"fork-sections",
+		 []([[maybe_unused]] std::span<const std::string_view> args) {
+			 if(!internal::fork::supported())
+			 {
+				 std::cout << "'--fork-sections' is not supported on this platform, sections will be replayed"
+						   << std::endl;
+				 return;
+			 }
+			 // forking a process that runs several threads is unsafe
+			 internal::config->fork_sections   = true;
+			 internal::config->single_threaded = true;
+		 }},
+		{"workers",
+		 [](std::span<const std::string_view> args) {
+			 if(!internal::workers::supported())
+			 {
+				 std::cout << "'--workers' is not supported on this platform, suites will run in this process"
+						   << std::endl;
+				 return;
+			 }
+			 internal::config->workers = std::stoul(std::string(args[0]));
+		 },
+		 1, 0},
+		{"worker-timeout",
+		 [](std::span<const std::string_view> args) {
+			 const auto seconds = std::stod(std::string(args[0]));
+			 internal::except(!(seconds > 0.0),
+							  std::runtime_error("'--worker-timeout' should be a positive amount of seconds"));
+			 internal::config->worker_timeout =
+				 std::chrono::milliseconds(std::max<std::int64_t>(static_cast<std::int64_t>(seconds * 1000.0), 1));
+		 },
+		 1, 0},
 		{"break",
 		 []([[maybe_unused]] std::span<const std::string_view> args) {
 			 internal::config->break_on_fatal = args[0] == "on-fatal";
@@ -121,6 +177,63 @@ void configure(std::span<const std::string_view> args)
 			 }
 		 },
 		 1, 0},
+		{"seed",
+		 [](std::span<const std::string_view> args) { internal::config->seed = std::stoull(std::string(args[0])); },
+		 1, 0},
+		{"aggregate",
+		 [](std::span<const std::string_view> args) {
+			 internal::config->aggregate = std::stoul(std::string(args[0]));
+		 },
+		 1, 0},
+		{"benchmarks",
+		 [](std::span<const std::string_view> args) {
+			 internal::config->benchmarks = (!args.empty() && args[0] == "only") ? benchmark_mode_t::only
+																				  : benchmark_mode_t::after;
+		 },
+		 0, 1},
+		{"pin-cpu",
+		 [](std::span<const std::string_view> args) { internal::config->pin_cpu = std::stoul(std::string(args[0])); },
+		 1, 0},
+		{"list",
+		 [](std::span<const std::string_view> args) {
+			 internal::config->list =
+				 (!args.empty() && args[0] == "json") ? list_format_t::json : list_format_t::compact;
+		 },
+		 0, 1},
+		{"durations", [](std::span<const std::string_view> args) { internal::config->durations = args[0]; }, 1, 0},
+		{"corpus", [](std::span<const std::string_view> args) { internal::config->corpus = args[0]; }, 1, 0},
+		{"update-snapshots",
+		 []([[maybe_unused]] std::span<const std::string_view> args) { internal::config->update_snapshots = true; }},
+		{"progress",
+		 [](std::span<const std::string_view> args) {
+			 // a status line redrawn every second on a terminal, a log line every 10 seconds otherwise
+			 const auto seconds = !args.empty() ? std::stod(std::string(args[0]))
+												: (progress_reporter_t::terminal() ? 1.0 : 10.0);
+			 // a zero interval would redraw the status line in a busy loop
+			 internal::except(!(seconds > 0.0),
+							  std::runtime_error("'--progress' should be a positive amount of seconds"));
+			 internal::config->progress =
+				 std::chrono::milliseconds(std::max<std::int64_t>(static_cast<std::int64_t>(seconds * 1000.0), 1));
+		 },
+		 0, 1},
+		{"timing",
+		 [](std::span<const std::string_view> args) {
+			 const std::unordered_map<std::string_view, clock_source_t> sources{
+				 {"steady", clock_source_t::steady},
+				 {"tsc", clock_source_t::tsc},
+				 {"monotonic-raw", clock_source_t::monotonic_raw},
+				 {"none", clock_source_t::none}};
+			 const auto source = sources.find(args[0]);
+			 if(internal::except(source == std::end(sources),
+								 std::runtime_error("unknown clock '" + std::string(args[0]) + "' for '--timing'")))
+				 return;
+			 if(!timing::select(source->second))
+				 std::cout << "'--timing " << args[0] << "' is not supported on this machine, using the steady clock"
+						   << std::endl;
+			 timing::state.scopes = args.size() < 2 || args[1] != "suites";
+		 },
+		 1, 1},
+		{"histograms", [](std::span<const std::string_view> args) { internal::config->histograms = args[0]; }, 1, 0},
 		{"source-size-limit",
 		 [](std::span<const std::string_view> args) {
 			 internal::config->source_size_limit = std::stoul(std::string(args[0]));
@@ -209,6 +322,16 @@ auto litmus::run(int argc, char* argv[],
 		formatter->set_stream(*filestream, false);
 	}
 
+	std::optional<duration_history_t> history{};
+	if(!config->durations.empty()) history.emplace(config->durations);
+
+	// '--list' only reads the registrations, nothing runs
+	if(config->list)
+	{
+		list_permutations(output_file.empty() ? std::cout : *filestream, *config->list, history ? &*history : nullptr);
+		return 0;
+	}
+
 	size_t fatal{0};
 	size_t fail{0};
 	size_t pass{0};
@@ -228,58 +351,297 @@ auto litmus::run(int argc, char* argv[],
 		source_location location;
 		std::vector<std::pair<std::vector<std::string>, size_t>> templates{};
 		std::vector<test_result_t> results{};
+		// permutation every result originates from, its parameters are described when it's formatted
+		std::vector<std::pair<const permutations_t*, size_t>> origins{};
+		// ordinal of every result within its template arguments, see `duration_history_t::key`
+		std::vector<size_t> ordinals{};
 		bool skipped;
+		// permutations that both passed and failed over their runs, see `repeat::fold`
+		size_t flaky{0};
+		// the output of the suite, when it was formatted on the thread that ran it
+		std::optional<std::string> formatted{};
 	};
 
-	auto run_suite = [](const char* name, const runner_t::test_t& test_units,
-						std::span<std::string> categories = std::span<std::string>{}) -> suite_results_t {
+	// '--benchmarks only' replaces the tests
+	const auto run_tests	  = config->benchmarks != benchmark_mode_t::only;
+	const auto run_benchmarks = config->benchmarks != benchmark_mode_t::skip && !internal::runner.benchmarks().empty();
+
+	// '--repeat' and '--until-fail', the runs every test permutation has at most (benchmarks run once)
+	const auto runs = repeat::active() ? repeat::runs() : size_t{1};
+
+	std::optional<progress_reporter_t> progress{};
+	if(config->progress)
+	{
+		size_t permutations{0};
+		size_t suites{0};
+		auto count = [&permutations, &suites](const auto& registrations, size_t runs) {
+			for(const auto& [name, test_units] : registrations)
+			{
+				suites += test_units.empty() ? 0 : 1;
+				for(const auto& [uid, tests] : test_units)
+					for(const auto& registration : tests.permutations) permutations += registration->size() * runs;
+			}
+		};
+		if(run_tests) count(internal::runner, runs);
+		if(run_benchmarks) count(internal::runner.benchmarks(), 1);
+
+		std::optional<std::chrono::microseconds> expected{};
+		if(history)
+		{
+			const auto tests	  = run_tests ? expected_duration(*history, true, false) : std::nullopt;
+			const auto benchmarks = run_benchmarks ? expected_duration(*history, false, true) : std::nullopt;
+			if(tests || benchmarks)
+				expected = tests.value_or(std::chrono::microseconds{0}) * static_cast<std::int64_t>(runs) +
+						   benchmarks.value_or(std::chrono::microseconds{0});
+		}
+		progress.emplace(*config->progress, permutations, suites, expected);
+	}
+
+	// the permutations of a suite in the order they are formatted in, with an (empty) result for each of them
+	auto plan_suite = [](const char* name, const runner_t::test_t& test_units) -> suite_results_t {
 		suite_results_t result{};
 		result.name = name;
-		if(test_units.empty()) return {};
+		size_t total{0};
+		for(const auto& [uid, tests] : test_units)
+			for(const auto& permutations : tests.permutations) total += permutations->size();
+
+		result.results.resize(total);
+		result.origins.reserve(total);
+		result.ordinals.reserve(total);
+		for(const auto& [uid, tests] : test_units)
+		{
+			auto& [templates, size] = result.templates.emplace_back(tests.templates, 0u);
+			for(const auto& permutations : tests.permutations)
+			{
+				for(size_t index = 0; index < permutations->size(); ++index, ++size)
+				{
+					result.origins.emplace_back(permutations.get(), index);
+					result.ordinals.emplace_back(size);
+				}
+			}
+		}
+		return result;
+	};
+
+	// drops the permutations that did not run (e.g. filtered categories), and sums up the results of the others
+	auto collect_suite = [](suite_results_t& result) {
 		size_t local_fatal{0};
 		size_t local_fail{0};
 		size_t local_pass{0};
 		std::chrono::microseconds local_duration{};
 
-		std::chrono::microseconds suite_duration{};
-		for(const auto& [uid, tests] : test_units)
+		size_t kept{0};
+		size_t read{0};
+		size_t groups{0};
+		for(size_t group = 0; group < result.templates.size(); ++group)
 		{
-			result.templates.emplace_back(tests.templates, tests.functions.size());
-			for(const auto& test : tests.functions)
+			size_t count{0};
+			for(const auto end = read + result.templates[group].second; read < end; ++read)
 			{
-				auto res = test();
-				if(res.results.empty()) continue;
-				result.results.emplace_back(std::move(res));
-
-				result.results.back().get_result_values(local_pass, local_fail, local_fatal, local_duration);
+				if(result.results[read].results.empty()) continue;
+				if(kept != read)
+				{
+					result.results[kept]  = std::move(result.results[read]);
+					result.origins[kept]  = result.origins[read];
+					result.ordinals[kept] = result.ordinals[read];
+				}
+				result.results[kept].get_result_values(local_pass, local_fail, local_fatal, local_duration);
 				result.pass += local_pass;
 				result.fail += local_fail;
 				result.fatal += local_fatal;
 				result.duration += local_duration;
+				++kept;
+				++count;
 			}
+			if(count == 0) continue;
+			if(groups != group) result.templates[groups].first = std::move(result.templates[group].first);
+			result.templates[groups++].second = count;
 		}
+		result.templates.erase(std::next(std::begin(result.templates), groups), std::end(result.templates));
+		result.results.erase(std::next(std::begin(result.results), kept), std::end(result.results));
+		result.origins.erase(std::next(std::begin(result.origins), kept), std::end(result.origins));
+		result.ordinals.erase(std::next(std::begin(result.ordinals), kept), std::end(result.ordinals));
 		result.skipped = result.results.empty();
 		if(!result.skipped) result.location = std::begin(result.results)->root().location;
+	};
+
+	// `repeatable` is false for benchmarks, they run once whatever '--repeat' says
+	auto run_suite = [&plan_suite, &collect_suite, &progress](const char* name, const runner_t::test_t& test_units,
+															  std::span<std::string> categories =
+																  std::span<std::string>{},
+															  bool repeatable = true) -> suite_results_t {
+		if(test_units.empty()) return {};
+		auto result = plan_suite(name, test_units);
+
+		// coroutine suites are all started before the loop runs, so they interleave while they wait
+		event_loop_t loop{};
+		for(size_t i = 0; i < result.results.size(); ++i)
+		{
+			const auto& [permutations, index] = result.origins[i];
+			if(repeatable && repeat::active())
+			{
+				// the runs of a permutation follow each other, they'd share its state otherwise
+				std::vector<test_result_t> runs{};
+				while(repeat::again(runs))
+				{
+					runs.emplace_back(repeat::attempt([&permutations, index] { return permutations->run(index); }));
+					if(progress) progress->permutation_done(runs.back());
+				}
+				auto folded		  = repeat::fold(std::move(runs), *permutations, index);
+				result.results[i] = std::move(folded.result);
+				result.flaky += folded.flaky ? 1 : 0;
+			}
+			else if(permutations->is_async())
+				permutations->start(index, loop, result.results[i]);
+			else
+			{
+				result.results[i] = permutations->run(index);
+				if(progress) progress->permutation_done(result.results[i]);
+			}
+		}
+		loop.run();
+
+		// the permutations of a registration are planned next to each other, in index order
+		for(size_t i = 0; i < result.results.size(); i += result.origins[i].first->size())
+			result.origins[i].first->conclude(
+				std::span{result.results}.subspan(i, result.origins[i].first->size()));
+
+		if(progress)
+		{
+			for(size_t i = 0; i < result.results.size(); ++i)
+				if(result.origins[i].first->is_async() && !(repeatable && repeat::active()))
+					progress->permutation_done(result.results[i]);
+			progress->suite_done();
+		}
+		collect_suite(result);
 		return result;
 	};
 
-	auto format_suite = [&formatter](const suite_results_t& suite) {
-		formatter->suite_begin(suite.name, suite.pass, suite.fail, suite.fatal, suite.location, suite.duration);
+	// '--durations', recorded as the results are reported
+	auto record_suite = [&history](const suite_results_t& suite) {
+		if(!history) return;
+		auto result	 = std::begin(suite.results);
+		auto ordinal = std::begin(suite.ordinals);
+		for(const auto& [templates, tests_size] : suite.templates)
+		{
+			for(auto i = 0u; i < tests_size; ++i, ++result, ++ordinal)
+				history->record(duration_history_t::key(suite.name, templates, *ordinal),
+								std::chrono::duration_cast<std::chrono::microseconds>(result->root().duration()));
+		}
+	};
+
+	auto format_suite = [](suite_results_t& suite, litmus::formatter& output) {
+		output.suite_begin(suite.name, suite.pass, suite.fail, suite.fatal, suite.location, suite.duration);
 		auto result = std::begin(suite.results);
+		auto origin = std::begin(suite.origins);
 		for(const auto& [templates, tests_size] : suite.templates)
 		{
-			if(!templates.empty()) formatter->suite_iterate_templates(templates);
+			if(!templates.empty()) output.suite_iterate_templates(templates);
 			for(auto i = 0u; i < tests_size; ++i)
 			{
-				formatter->suite_iterate(templates, result->root().parameters);
-				result->to_string(formatter);
+				auto& root = std::get<test_result_t::scope_t>(result->results[0]);
+				if(root.parameters.empty()) root.parameters = origin->first->describe(origin->second);
+				origin = std::next(origin);
+
+				output.suite_iterate(templates, root.parameters);
+				result->to_string(&output);
 				result = std::next(result);
 			}
 		}
-		formatter->suite_end(suite.name, suite.pass, suite.fail, suite.fatal, suite.location, suite.duration);
+		output.suite_end(suite.name, suite.pass, suite.fail, suite.fatal, suite.location, suite.duration);
+	};
+
+	// formats the suite, or writes the output a clone of the formatter already produced for it
+	std::vector<std::pair<const char*, size_t>> flaky{};
+	auto report_suite = [&formatter, &progress, &flaky, &record_suite, &format_suite](suite_results_t& suite) {
+		record_suite(suite);
+		if(suite.flaky > 0) flaky.emplace_back(suite.name, suite.flaky);
+		// the status line is cleared, and only drawn again once the output of the suite is out
+		auto paused = progress ? progress->pause() : std::unique_lock<std::mutex>{};
+		if(suite.formatted)
+			formatter->append(*suite.formatted);
+		else
+			format_suite(suite, *formatter);
+		if(progress) formatter->flush();
 	};
 
-	if(config->single_threaded)
+	if(run_tests && config->workers > 0)
+	{
+		/*
+			every run of a permutation is a work item, the workers pick them up in the order the suites are formatted
+			in. The runs of a permutation are spread over the workers, so '--until-fail' can't stop at the first
+			failing one, the runs after it are dropped when they're folded.
+		*/
+		std::vector<suite_results_t> suites{};
+		std::vector<std::pair<size_t, size_t>> items{};
+		suites.reserve(internal::runner.size());
+		for(const auto& [name, test_units] : internal::runner)
+		{
+			if(test_units.empty()) continue;
+			const auto& suite = suites.emplace_back(plan_suite(name, test_units));
+			for(size_t i = 0; i < suite.results.size(); ++i)
+				for(size_t run = 0; run < runs; ++run) items.emplace_back(suites.size() - 1, i);
+		}
+
+		// the results come in through this process, a suite is done once its last permutation is in
+		std::vector<size_t> outstanding(suites.size());
+		for(const auto& [suite, index] : items) ++outstanding[suite];
+		auto finished = [&progress, &items, &outstanding](size_t item, const std::optional<test_result_t>& result) {
+			if(!progress) return;
+			progress->permutation_done(result ? *result : test_result_t{});
+			if(--outstanding[items[item].first] == 0) progress->suite_done();
+		};
+
+		auto results = workers::run(
+			config->workers, items.size(),
+			[&suites, &items](size_t item) -> test_result_t {
+				const auto& [permutations, index] = suites[items[item].first].origins[items[item].second];
+				if(!repeat::active()) return permutations->run(index);
+				return repeat::attempt([&permutations, index] { return permutations->run(index); });
+			},
+			finished, config->worker_timeout);
+
+		for(size_t item = 0; item < items.size(); item += runs)
+		{
+			auto& suite						  = suites[items[item].first];
+			const auto& [permutations, index] = suite.origins[items[item].second];
+			std::vector<test_result_t> attempts(runs);
+			for(size_t run = 0; run < runs; ++run)
+			{
+				auto& res	  = attempts[run];
+				auto& outcome = results[item + run];
+				if(outcome.result)
+				{
+					res = std::move(*outcome.result);
+					continue;
+				}
+				// only how the worker ended is known, the record names the worker and the permutation it ran
+				res.scope_open(suite.name, {}, permutations->location());
+				res.expect_result(outcome.termination, "completed", {}, {}, test_result_t::expect_t::operation_t::equal,
+								  false, true,
+								  combine_text("worker ", std::to_string(outcome.pid), " ", outcome.termination,
+											   " while running permutation ", std::to_string(index), " of '",
+											   std::string{suite.name}, "', its results are missing"));
+				res.scope_close();
+				res.sync();
+			}
+			auto folded = repeat::fold(std::move(attempts), *permutations, index);
+			suite.results[items[item].second] = std::move(folded.result);
+			suite.flaky += folded.flaky ? 1 : 0;
+		}
+
+		for(auto& suite : suites)
+		{
+			collect_suite(suite);
+			if(suite.skipped) continue;
+			pass += suite.pass;
+			fail += suite.fail;
+			fatal += suite.fatal;
+			duration += suite.duration;
+			report_suite(suite);
+		}
+	}
+	else if(run_tests && config->single_threaded)
 	{
 		for(const auto& [name, test_units] : internal::runner)
 		{
@@ -289,19 +651,30 @@ auto litmus::run(int argc, char* argv[],
 			fail += suite.fail;
 			fatal += suite.fatal;
 			duration += suite.duration;
-			format_suite(suite);
+			report_suite(suite);
 		}
 	}
-	else
+	else if(run_tests)
 	{
 		std::vector<std::future<suite_results_t>> suite_results{};
 		suite_results.reserve(internal::runner.size());
 		for(const auto& runner : internal::runner)
 		{
 			std::packaged_task<suite_results_t()> task(
-				[&run_suite, name = runner.first, test_units = runner.second,
+				[&run_suite, &format_suite, formatter = static_cast<const litmus::formatter*>(formatter),
+				 name = runner.first, &test_units = runner.second,
 				 categories = std::span<std::string>{config->categories}]() -> suite_results_t {
-					return run_suite(name, test_units, categories);
+					auto suite = run_suite(name, test_units, categories);
+					if(suite.skipped) return suite;
+
+					// formatted into a buffer of its own, the runner only has to write the buffers out in order
+					std::ostringstream buffer{};
+					if(auto clone = formatter->clone(buffer); clone)
+					{
+						format_suite(suite, *clone);
+						suite.formatted = std::move(buffer).str();
+					}
+					return suite;
 				});
 			suite_results.emplace_back(task.get_future());
 			std::thread(std::move(task)).detach();
@@ -315,13 +688,97 @@ auto litmus::run(int argc, char* argv[],
 			fail += suite.fail;
 			fatal += suite.fatal;
 			duration += suite.duration;
-			format_suite(suite);
+			report_suite(suite);
 		}
 	}
 
+	/*
+		benchmarks run one at a time on a single core after the tests have finished, so they don't compete with them
+		(or each other) for the cpu, and are not migrated while they are measured
+	*/
+	if(run_benchmarks)
+	{
+		cpu_pin_t pin{config->pin_cpu};
+		if(!pin.cpu()) std::cerr << "warning: benchmarks could not be pinned to a cpu" << std::endl;
+		for(const auto& warning : noisy_environment(pin.cpu())) std::cerr << "warning: " << warning << std::endl;
+
+		for(const auto& [name, benchmark_units] : internal::runner.benchmarks())
+		{
+			auto benchmark = run_suite(name, benchmark_units, {}, false);
+			if(benchmark.skipped) continue;
+			pass += benchmark.pass;
+			fail += benchmark.fail;
+			fatal += benchmark.fatal;
+			duration += benchmark.duration;
+			report_suite(benchmark);
+		}
+	}
+
+	progress.reset();
 	formatter->write_totals(
 		pass, fail, fatal, duration,
 		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - real_start));
 	formatter->flush();
+	for(const auto& [name, count] : flaky)
+		std::cerr << "warning: " << count << ((count == 1) ? " flaky permutation" : " flaky permutations") << " in "
+				  << name << std::endl;
+	if(history) history->save(config->durations);
 	return (fail > 0 || fatal > 0) ? 1 : 0;
 }
+
+auto litmus::fuzz(const std::uint8_t* data, size_t size) noexcept -> int
+{
+	struct target_t
+	{
+		const char* name;
+		const std::vector<std::string>* templates;
+		const permutations_t* permutations;
+		size_t index;
+	};
+
+	// the permutations of the suites with a corpus argument, gathered once as the fuzzer calls in for every input
+	static const auto targets = [] {
+		config->no_source = true;
+		config->fuzzing	  = true;
+		std::vector<target_t> res{};
+		for(const auto& [name, test_units] : internal::runner)
+		{
+			for(const auto& [uid, tests] : test_units)
+			{
+				for(const auto& permutations : tests.permutations)
+				{
+					if(!permutations->fuzzable()) continue;
+					for(size_t index = 0; index < permutations->size(); ++index)
+						res.emplace_back(target_t{name, &tests.templates, permutations.get(), index});
+				}
+			}
+		}
+		return res;
+	}();
+
+	const std::span<const std::byte> input{reinterpret_cast<const std::byte*>(data), size};
+	for(const auto& target : targets)
+	{
+		test_result_t result{};
+		target.permutations->fuzz(target.index, input, result);
+		if(result.results.empty()) continue;
+		const auto& root = result.root();
+		if(root.fail == 0 && root.fatal == 0) continue;
+
+		// the failure is written out in full before the fuzzer is told about it, which only sees the crash
+		formatters::detailed_stream_formatter_no_color output{};
+		litmus::formatter& formatter = output;
+		formatter.set_stream(std::cerr, false);
+		formatter.begin(1);
+		formatter.suite_begin(target.name, root.pass, root.fail, root.fatal, root.location,
+							  std::chrono::duration_cast<std::chrono::microseconds>(root.duration()));
+		formatter.suite_iterate(*target.templates, root.parameters);
+		result.to_string(&formatter);
+		formatter.suite_end(target.name, root.pass, root.fail, root.fatal, root.location,
+							std::chrono::duration_cast<std::chrono::microseconds>(root.duration()));
+		formatter.end();
+		formatter.flush();
+		std::abort();
+	}
+	return 0;
+}
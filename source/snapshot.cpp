@@ -0,0 +1,285 @@
+#include <litmus/snapshot.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <litmus/details/mapped_file.hpp>
+#include <litmus/details/test_result.hpp>
+#include <litmus/details/utility.hpp>
+#include <litmus/litmus.hpp>
+
+using namespace litmus::internal;
+
+namespace
+{
+	constexpr std::uint64_t prime1{0x9E3779B185EBCA87ull};
+	constexpr std::uint64_t prime2{0xC2B2AE3D27D4EB4Full};
+	constexpr std::uint64_t prime3{0x165667B19E3779F9ull};
+	constexpr std::uint64_t prime4{0x85EBCA77C2B2AE63ull};
+	constexpr std::uint64_t prime5{0x27D4EB2F165667C5ull};
+
+	constexpr auto rotl(std::uint64_t x, int k) noexcept -> std::uint64_t { return (x << k) | (x >> (64 - k)); }
+
+	// little endian reads, the hashes are only compared with those of the same host
+	template <typename T>
+	auto read(const std::byte* data) noexcept -> std::uint64_t
+	{
+		T res{};
+		std::memcpy(&res, data, sizeof(T));
+		return static_cast<std::uint64_t>(res);
+	}
+
+	constexpr auto mix(std::uint64_t accumulator, std::uint64_t input) noexcept -> std::uint64_t
+	{
+		return rotl(accumulator + input * prime2, 31) * prime1;
+	}
+
+	constexpr auto merge(std::uint64_t hash, std::uint64_t accumulator) noexcept -> std::uint64_t
+	{
+		return (hash ^ mix(0, accumulator)) * prime1 + prime4;
+	}
+
+	// a snapshot and the files kept next to it
+	struct snapshot_paths_t
+	{
+		std::filesystem::path snapshot;
+		std::filesystem::path hash;
+		std::filesystem::path actual;
+	};
+
+	auto paths(std::string_view name, const source_location& location) -> snapshot_paths_t
+	{
+		// resolved like the source excerpts are, relative `__FILE__` paths need the '--source' prefix
+		auto snapshot = std::filesystem::path{config->source + location.file_name()}.parent_path() /
+						LITMUS_SNAPSHOT_DIRECTORY / std::filesystem::path{name};
+		auto hash	= snapshot;
+		auto actual = snapshot;
+		hash += ".hash";
+		actual += ".actual";
+		return {std::move(snapshot), std::move(hash), std::move(actual)};
+	}
+
+	auto hash_text(std::uint64_t hash, size_t size) -> std::string
+	{
+		std::string hex(16, '0');
+		char buffer[16]{};
+		const auto [end, error] = std::to_chars(std::begin(buffer), std::end(buffer), hash, 16);
+		std::copy(std::begin(buffer), end, std::next(std::begin(hex), 16 - (end - std::begin(buffer))));
+		return combine_text("xxh64 ", hex, " ", std::to_string(size), "\n");
+	}
+
+	/*
+		the hash stored next to the snapshot, only when it can be trusted: the snapshot wasn't written after its hash
+		was, and is still the size the hash was taken of
+	*/
+	auto stored_hash(const snapshot_paths_t& paths) -> std::optional<std::uint64_t>
+	{
+		std::error_code error{};
+		const auto snapshot_time = std::filesystem::last_write_time(paths.snapshot, error);
+		if(error) return std::nullopt;
+		const auto hash_time = std::filesystem::last_write_time(paths.hash, error);
+		if(error || hash_time < snapshot_time) return std::nullopt;
+		const auto size = std::filesystem::file_size(paths.snapshot, error);
+		if(error) return std::nullopt;
+
+		std::ifstream stream(paths.hash);
+		std::string algorithm{};
+		std::string hex{};
+		size_t stored_size{0};
+		if(!(stream >> algorithm >> hex >> stored_size) || algorithm != "xxh64" || stored_size != size)
+			return std::nullopt;
+		std::uint64_t res{0};
+		const auto [end, parse_error] = std::from_chars(hex.data(), hex.data() + hex.size(), res, 16);
+		if(parse_error != std::errc{} || end != hex.data() + hex.size()) return std::nullopt;
+		return res;
+	}
+
+	// written to a temporary file next to `path` first, which then replaces it
+	auto write_atomic(const std::filesystem::path& path, std::span<const std::byte> bytes) -> bool
+	{
+		std::error_code error{};
+		std::filesystem::create_directories(path.parent_path(), error);
+
+		auto temporary = path;
+		temporary += combine_text(".", std::to_string(std::random_device{}()), ".",
+								  std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())), ".tmp");
+		{
+			std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+			if(!stream.is_open()) return false;
+			stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+			stream.close();
+			if(stream.fail())
+			{
+				std::filesystem::remove(temporary, error);
+				return false;
+			}
+		}
+		std::filesystem::rename(temporary, path, error);
+		if(!error) return true;
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+
+	auto write_atomic(const std::filesystem::path& path, std::string_view text) -> bool
+	{
+		return write_atomic(path,
+							std::span<const std::byte>{reinterpret_cast<const std::byte*>(text.data()), text.size()});
+	}
+
+	// up to 40 bytes of the line around `offset`, non printable characters are escaped
+	auto excerpt(std::span<const std::byte> bytes, size_t begin, size_t offset) -> std::string
+	{
+		constexpr size_t length{40};
+		begin = std::max(begin, (offset > length / 2) ? offset - length / 2 : size_t{0});
+		std::string res{};
+		for(auto i = begin; i < bytes.size() && i < begin + length; ++i)
+		{
+			const auto ch = static_cast<unsigned char>(bytes[i]);
+			if(ch == '\n') break;
+			if(ch >= ' ' && ch <= '~' && ch != '\\')
+				res += static_cast<char>(ch);
+			else
+			{
+				constexpr std::string_view digits{"0123456789abcdef"};
+				res += "\\x";
+				res += digits[ch >> 4u];
+				res += digits[ch & 0xfu];
+			}
+		}
+		return res;
+	}
+
+	// the first byte at which `actual` and `expected` differ, and a description of the lines around it
+	auto describe_mismatch(std::span<const std::byte> actual, std::span<const std::byte> expected) -> std::string
+	{
+		const auto shared = std::min(actual.size(), expected.size());
+		const auto offset = static_cast<size_t>(
+			std::mismatch(std::begin(actual), std::next(std::begin(actual), shared), std::begin(expected)).first -
+			std::begin(actual));
+		const auto lines = static_cast<size_t>(
+			std::count(std::begin(expected), std::next(std::begin(expected), offset), std::byte{'\n'}));
+		const auto newline = std::find(std::make_reverse_iterator(std::next(std::begin(expected), offset)),
+									   std::rend(expected), std::byte{'\n'});
+		const auto line_begin = static_cast<size_t>(std::distance(std::begin(expected), newline.base()));
+
+		auto res = combine_text("differs at byte ", std::to_string(offset), " (line ", std::to_string(lines + 1), ")");
+		if(actual.size() != expected.size())
+			res += combine_text(", ", std::to_string(actual.size()), " bytes instead of ",
+								std::to_string(expected.size()));
+		return combine_text(res, ": '", excerpt(actual, line_begin, offset), "' instead of '",
+							excerpt(expected, line_begin, offset), "'");
+	}
+} // namespace
+
+auto litmus::internal::snapshot_hash(std::span<const std::byte> bytes) noexcept -> std::uint64_t
+{
+	const auto* data = bytes.data();
+	const auto* end	 = data + bytes.size();
+	std::uint64_t hash{};
+	if(bytes.size() >= 32)
+	{
+		std::uint64_t accumulators[4]{prime1 + prime2, prime2, 0, 0 - prime1};
+		for(; data + 32 <= end; data += 32)
+		{
+			accumulators[0] = mix(accumulators[0], read<std::uint64_t>(data));
+			accumulators[1] = mix(accumulators[1], read<std::uint64_t>(data + 8));
+			accumulators[2] = mix(accumulators[2], read<std::uint64_t>(data + 16));
+			accumulators[3] = mix(accumulators[3], read<std::uint64_t>(data + 24));
+		}
+		hash = rotl(accumulators[0], 1) + rotl(accumulators[1], 7) + rotl(accumulators[2], 12) +
+			   rotl(accumulators[3], 18);
+		for(auto accumulator : accumulators) hash = merge(hash, accumulator);
+	}
+	else
+		hash = prime5;
+
+	hash += static_cast<std::uint64_t>(bytes.size());
+	for(; data + 8 <= end; data += 8) hash = rotl(hash ^ mix(0, read<std::uint64_t>(data)), 27) * prime1 + prime4;
+	if(data + 4 <= end)
+	{
+		hash = rotl(hash ^ (read<std::uint32_t>(data) * prime1), 23) * prime2 + prime3;
+		data += 4;
+	}
+	for(; data < end; ++data) hash = rotl(hash ^ (static_cast<std::uint64_t>(*data) * prime5), 11) * prime1;
+
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+auto litmus::internal::compare_snapshot(std::span<const std::byte> bytes, std::string_view name,
+										const source_location& location) -> snapshot_outcome_t
+{
+	// threads attached to a suite have no scopes of their own, the call site stands in for the suite there
+	const auto& origin =
+		(remote_target.queue || suite_context.output.results.empty()) ? location : suite_context.output.root().location;
+	const auto files = paths(name, origin);
+	const auto hash	 = snapshot_hash(bytes);
+	snapshot_outcome_t res{true, combine_text(std::string{name}, ", ", std::to_string(bytes.size()), " bytes"),
+						   files.snapshot.string(), {}};
+
+	auto update = [&]() -> snapshot_outcome_t& {
+		res.pass = write_atomic(files.snapshot, bytes) && write_atomic(files.hash, hash_text(hash, bytes.size()));
+		res.info = res.pass ? "the snapshot was updated" : "the snapshot could not be written";
+		std::error_code error{};
+		if(res.pass) std::filesystem::remove(files.actual, error);
+		return res;
+	};
+
+	std::error_code error{};
+	if(!std::filesystem::is_regular_file(files.snapshot, error))
+	{
+		if(config->update_snapshots) return update();
+		res.pass = false;
+		res.info = "the snapshot does not exist, run with '--update-snapshots' to create it";
+		return res;
+	}
+
+	// a match leaves a stale `.actual` behind otherwise, '--update-snapshots' also records the hash of the match
+	auto matched = [&]() -> snapshot_outcome_t& {
+		if(config->update_snapshots) write_atomic(files.hash, hash_text(hash, bytes.size()));
+		std::filesystem::remove(files.actual, error);
+		return res;
+	};
+
+	// a trusted hash that matches is all it takes, only the output itself was read
+	const auto stored = stored_hash(files);
+	if(stored && *stored == hash) return matched();
+
+	std::string mismatch{};
+	{
+		mapped_file_t snapshot{files.snapshot.string(), error};
+		if(error)
+		{
+			res.pass = false;
+			res.info = combine_text("the snapshot could not be read: ", error.message());
+			return res;
+		}
+		snapshot.sequential(0, snapshot.size());
+		const auto expected = snapshot.bytes();
+		if(expected.size() != bytes.size() ||
+		   !std::equal(std::begin(bytes), std::end(bytes), std::begin(expected), std::end(expected)))
+			mismatch = describe_mismatch(bytes, expected);
+	}
+	if(mismatch.empty()) return matched();
+
+	if(config->update_snapshots) return update();
+	res.pass = false;
+	res.info = combine_text("the output ", mismatch,
+							write_atomic(files.actual, bytes)
+								? combine_text(", it was written to ", files.actual.string())
+								: std::string{});
+	return res;
+}